@@ -2,20 +2,14 @@
 #include <stdio.h>
 #include <unistd.h> // 用于 usleep
 #include <atomic>
+#include "counter/AtomicUpdate.h"
 
 std::atomic<int> shared_counter{0};
               
 void* problematic_increment(void* arg) {
     for (int i = 0; i < 1000; i++) {
-        int expected = shared_counter.load(std::memory_order_relaxed); // 1. 读取当前值
-        // 2. 循环重试，直到成功为止
-        while (!shared_counter.compare_exchange_strong(expected, expected + 1,
-                                                       std::memory_order_release,
-                                                       std::memory_order_relaxed)) {
-            // 循环体在CAS失败时通常会为空
-            // 因为CAS失败时，`expected`已经被更新为`shared_counter`的最新值
-            // 循环会立即用这个新值再次尝试
-        }
+        // 读取当前值后 CAS，失败时用最新值重试，每次失败先暂停一下
+        atomic_update(shared_counter, [](int value) { return value + 1; }, PauseBackoff());
         usleep(1);
     }
     return NULL;
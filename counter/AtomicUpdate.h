@@ -0,0 +1,135 @@
+#ifndef ATOMICUPDATE_H
+#define ATOMICUPDATE_H
+
+#include <atomic>
+#include <thread>
+#include <functional>
+#include <sched.h>
+#include "Platform.h"
+
+/**
+ * @brief CAS 循环失败后的退避策略，atomic_update() 的模板参数
+ *
+ * 每次调用 atomic_update() 构造一个新的策略对象，CAS 每失败一次调用一次
+ * backoff()，因此指数类策略的等待上限在每次调用开始时复位。
+ * 每个策略提供 static const char* name()，用于测试输出。
+ */
+
+/**
+ * @brief 不退避：失败后立即重试（cas(atomic).cpp 最初的写法）
+ */
+struct NoBackoff {
+    static const char* name() { return "none"; }
+    void backoff() {}
+};
+
+/**
+ * @brief 每次失败执行一次 CPU 暂停提示
+ */
+struct PauseBackoff {
+    static const char* name() { return "pause"; }
+    void backoff() { cpu_relax(); }
+};
+
+/**
+ * @brief 指数退避：第 k 次失败暂停 min(MinSpins·2^k, MaxSpins) 轮
+ */
+template <unsigned MinSpins = 4, unsigned MaxSpins = 1024>
+class ExponentialBackoff {
+private:
+    unsigned limit = MinSpins;
+
+public:
+    static const char* name() { return "exponential"; }
+
+    void backoff() {
+        for (unsigned i = 0; i < limit; ++i) {
+            cpu_relax();
+        }
+        limit = limit * 2 < MaxSpins ? limit * 2 : MaxSpins;
+    }
+};
+
+/**
+ * @brief 随机指数退避：等待轮数在 [1, 当前上限] 内均匀随机，上限按指数增长
+ *
+ * 随机化使同时失败的线程错开重试时刻，避免它们再次同时冲突。
+ */
+template <unsigned MinSpins = 4, unsigned MaxSpins = 1024>
+class RandomizedExponentialBackoff {
+private:
+    unsigned limit = MinSpins;
+
+    /// 每个线程一个 xorshift 状态，不与其它线程共享
+    static unsigned next_random() {
+        thread_local unsigned state = static_cast<unsigned>(std::hash<std::thread::id>()(std::this_thread::get_id())) | 1u;
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+public:
+    static const char* name() { return "rand-exponential"; }
+
+    void backoff() {
+        const unsigned spins = 1 + next_random() % limit;
+        for (unsigned i = 0; i < spins; ++i) {
+            cpu_relax();
+        }
+        limit = limit * 2 < MaxSpins ? limit * 2 : MaxSpins;
+    }
+};
+
+/**
+ * @brief 前 N 次失败只暂停一次，之后每次失败都让出 CPU
+ *
+ * 超订时持有最新值的线程可能已被调度出去，继续自旋只会浪费时间片。
+ */
+template <unsigned N = 16>
+class YieldAfterBackoff {
+private:
+    unsigned failures = 0;
+
+public:
+    static const char* name() { return "yield-after-n"; }
+
+    void backoff() {
+        if (++failures > N) {
+            sched_yield();
+        } else {
+            cpu_relax();
+        }
+    }
+};
+
+/**
+ * @brief 以 CAS 循环把 target 更新为 fn(旧值)，失败时按 Backoff 退避
+ *
+ * fn 可能被调用多次（每次重试一次），必须没有副作用。
+ *
+ * @param target  被更新的原子变量
+ * @param fn      由旧值计算新值
+ * @param backoff 退避策略对象
+ * @param retries 若非空，写入本次调用中 CAS 失败的次数（每次都是因为其他线程改了值）
+ * @return 成功写入的新值
+ */
+template <typename T, typename Fn, typename Backoff = NoBackoff>
+T atomic_update(std::atomic<T>& target, Fn fn, Backoff backoff = Backoff(), unsigned* retries = nullptr) {
+    T expected = target.load(std::memory_order_relaxed);
+    T desired = fn(expected);
+    unsigned failures = 0;
+    // 失败时 expected 已被更新为最新值，只需重新计算 desired。
+    // 用 strong 而不是 weak：LL/SC 平台上 weak 的虚假失败会被计成冲突并触发退避
+    while (!target.compare_exchange_strong(expected, desired, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+        ++failures;
+        backoff.backoff();
+        desired = fn(expected);
+    }
+    if (retries != nullptr) {
+        *retries = failures;
+    }
+    return desired;
+}
+
+#endif // ATOMICUPDATE_H
@@ -0,0 +1,125 @@
+#ifndef BENCHMARKREPORT_H
+#define BENCHMARKREPORT_H
+
+#include <ctime>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <sys/utsname.h>
+#include "Platform.h"
+
+/**
+ * @brief 机器可读报告用到的主机信息与 CSV 读写工具
+ *
+ * 报告格式：开头若干行 "# 键=值" 记录主机信息，随后是带表头的 CSV，
+ * 每行一条测试结果。读取时按表头名定位列，新增列不影响旧基线的比较。
+ */
+
+/// 编译选项由 Makefile 以 -DCOUNTER_BUILD_FLAGS 传入
+#ifndef COUNTER_BUILD_FLAGS
+#define COUNTER_BUILD_FLAGS "unknown"
+#endif
+
+/**
+ * @brief 运行测试的主机与构建信息
+ */
+struct HostInfo {
+    std::string cpu_model;
+    unsigned cores = 0;
+    std::string kernel;
+    std::string compiler;
+    std::string flags;
+    std::string timestamp;          ///< 本地时间，ISO 8601 格式
+};
+
+/**
+ * @brief CPU 型号：x86 取 /proc/cpuinfo 的 model name，ARM 等取 Hardware/CPU part
+ */
+inline std::string cpu_model_name() {
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    std::string fallback = "unknown";
+    while (std::getline(cpuinfo, line)) {
+        const size_t colon = line.find(':');
+        if (colon == std::string::npos) {
+            continue;
+        }
+        std::string key = line.substr(0, colon);
+        key.erase(key.find_last_not_of(" \t") + 1);
+        const size_t begin = line.find_first_not_of(" \t", colon + 1);
+        const std::string value = begin == std::string::npos ? "" : line.substr(begin);
+        if (key == "model name") {
+            return value;
+        }
+        if ((key == "Hardware" || key == "CPU part") && fallback == "unknown") {
+            fallback = value;
+        }
+    }
+    return fallback;
+}
+
+inline HostInfo host_info() {
+    HostInfo info;
+    info.cpu_model = cpu_model_name();
+    info.cores = online_cpus();
+    utsname name;
+    info.kernel = uname(&name) == 0 ? std::string(name.sysname) + " " + name.release + " " + name.machine : "unknown";
+#if defined(__clang__)
+    info.compiler = "clang " __clang_version__;
+#elif defined(__GNUC__)
+    info.compiler = "gcc " __VERSION__;
+#else
+    info.compiler = "unknown";
+#endif
+    info.flags = COUNTER_BUILD_FLAGS;
+    char buffer[32];
+    const std::time_t now = std::time(nullptr);
+    std::tm local;
+    localtime_r(&now, &local);
+    info.timestamp = std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%S", &local) > 0 ? buffer : "";
+    return info;
+}
+
+/**
+ * @brief 把字段包成 CSV 引号字段，内部的引号双写
+ */
+inline std::string csv_field(const std::string& value) {
+    std::string quoted = "\"";
+    for (char c : value) {
+        if (c == '"') {
+            quoted += '"';
+        }
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+/**
+ * @brief 拆分一行 CSV，支持引号字段与双写的引号（字段内不能有换行）
+ */
+inline std::vector<std::string> parse_csv_line(const std::string& line) {
+    std::vector<std::string> fields(1);
+    bool quoted = false;
+    for (size_t i = 0; i < line.size(); ++i) {
+        const char c = line[i];
+        if (quoted) {
+            if (c == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+                fields.back() += '"';
+                ++i;
+            } else if (c == '"') {
+                quoted = false;
+            } else {
+                fields.back() += c;
+            }
+        } else if (c == '"') {
+            quoted = true;
+        } else if (c == ',') {
+            fields.emplace_back();
+        } else if (c != '\r') {
+            fields.back() += c;
+        }
+    }
+    return fields;
+}
+
+#endif // BENCHMARKREPORT_H
@@ -0,0 +1,105 @@
+#ifndef COHORTLOCK_H
+#define COHORTLOCK_H
+
+#include "Platform.h"
+#include "Topology.h"
+#include "TicketLock.h"
+
+/**
+ * @brief 锁交接统计，只由持锁者更新，读取应在所有线程停止后进行
+ */
+struct CohortLockStats {
+    unsigned long same_node_handoffs = 0;     ///< 上一个持有者与本次持有者在同一节点
+    unsigned long cross_node_handoffs = 0;    ///< 上一个持有者在其它节点
+    unsigned long local_passes = 0;           ///< 释放时直接交给本节点等待者（保留全局锁）
+    unsigned long global_releases = 0;        ///< 释放时归还全局锁
+};
+
+/**
+ * @brief NUMA 感知的层次化 cohort 锁策略 (C-TKT-TKT)
+ *
+ * 每个 NUMA 节点一把本地票据锁，外加一把全局票据锁。线程先取所在节点的
+ * 本地锁；本节点中拿到本地锁且节点尚未持有全局锁的线程再去竞争全局锁。
+ * 释放时若本节点还有等待者且连续本地交接未超过 MAX_LOCAL_HANDOFFS，
+ * 只释放本地锁，全局锁留在本节点，锁所在缓存行不必跨越互连；
+ * 否则归还全局锁，让其它节点有机会获得。
+ *
+ * 票据锁可由非获取者释放（thread-oblivious），满足 cohort 对全局锁的要求。
+ * 拓扑来自 sysfs；单节点机器上退化为本地锁 + 一把无竞争的全局锁。
+ */
+class CohortLockPolicy {
+private:
+    struct alignas(CACHE_LINE_SIZE) NodeLock {
+        TicketLockPolicy local;
+        bool global_owned = false;        ///< 本节点是否持有全局锁，受 local 保护
+        unsigned handoffs = 0;            ///< 连续本地交接次数，受 local 保护
+    };
+
+    TicketLockPolicy global;
+    NodeLock* node_locks;
+    int num_nodes;
+    int holder_node;                      ///< 当前持有者加锁时所在节点
+    int last_node;                        ///< 上一个持有者所在节点，-1 表示尚无
+    CohortLockStats statistics;
+
+public:
+    /// 全局锁在同一节点内连续交接的上限，保证其它节点不被饿死
+    static constexpr unsigned MAX_LOCAL_HANDOFFS = 64;
+
+    static const char* name() { return "cohort"; }
+
+    CohortLockPolicy()
+        : num_nodes(NumaTopology::instance().num_nodes()), holder_node(0), last_node(-1) {
+        node_locks = new NodeLock[num_nodes];
+    }
+
+    ~CohortLockPolicy() { delete[] node_locks; }
+
+    CohortLockPolicy(const CohortLockPolicy&) = delete;
+    CohortLockPolicy& operator=(const CohortLockPolicy&) = delete;
+
+    void lock() {
+        int node = NumaTopology::instance().current_node();
+        if (node >= num_nodes) {
+            node = 0;
+        }
+        NodeLock& node_lock = node_locks[node];
+        node_lock.local.lock();
+        if (!node_lock.global_owned) {
+            global.lock();
+            node_lock.global_owned = true;
+        }
+
+        holder_node = node;
+        if (last_node >= 0) {
+            if (last_node == node) {
+                ++statistics.same_node_handoffs;
+            } else {
+                ++statistics.cross_node_handoffs;
+            }
+        }
+        last_node = node;
+    }
+
+    void unlock() {
+        NodeLock& node_lock = node_locks[holder_node];
+        if (node_lock.local.has_waiters() && node_lock.handoffs < MAX_LOCAL_HANDOFFS) {
+            ++node_lock.handoffs;
+            ++statistics.local_passes;
+        } else {
+            node_lock.handoffs = 0;
+            node_lock.global_owned = false;
+            ++statistics.global_releases;
+            global.unlock();
+        }
+        node_lock.local.unlock();
+    }
+
+    /// NUMA 节点数
+    int nodes() const { return num_nodes; }
+
+    /// 交接统计；应在没有线程持锁或等待时读取
+    const CohortLockStats& stats() const { return statistics; }
+};
+
+#endif // COHORTLOCK_H
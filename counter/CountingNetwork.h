@@ -0,0 +1,150 @@
+#ifndef COUNTINGNETWORK_H
+#define COUNTINGNETWORK_H
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include "Platform.h"
+#include "ThreadIndex.h"
+#include "ThreadSafeCounter.h"
+
+/**
+ * @brief 双调 (bitonic) 计数网络，分发互不相同的序号
+ *
+ * 网络由 log w·(log w + 1)/2 层平衡器 (balancer) 组成，每层 w/2 个。
+ * 令牌从某条输入线进入，每经过一个平衡器就按其翻转位交替走上/下输出线，
+ * 最后到达输出线 i，从该线的计数器领取 i, i+w, i+2w, ... 中的下一个值。
+ * 各输出线的值域互不相交，所以返回值总是唯一的；网络的阶梯性质保证
+ * 静止时已分发的值恰好是 0..n-1，没有空洞。
+ * 竞争被分散到每层 w/2 个平衡器和 w 个输出计数器上，每个单独占一个缓存行。
+ *
+ * 布线采用比较器方向一致的双调排序网络：宽度为 s 的合并阶段第一层
+ * 连接 i 与 i^(s-1)，其后各层连接 i 与 i^d（d = s/4 ... 1）。
+ */
+class CountingNetwork {
+private:
+    struct alignas(CACHE_LINE_SIZE) Balancer {
+        std::atomic<unsigned> toggle{0};
+    };
+
+    struct alignas(CACHE_LINE_SIZE) OutputCounter {
+        std::atomic<long> next{0};
+    };
+
+    unsigned width;
+    std::vector<unsigned> layer_masks;        ///< 每层的配对掩码：线 i 与 i ^ mask 相连
+    std::vector<unsigned> balancer_index;     ///< [层 * width + 线] -> 该层中的平衡器编号
+    Balancer* balancers;                      ///< [层 * width/2 + 平衡器编号]
+    OutputCounter* outputs;
+
+public:
+    /**
+     * @param network_width 网络宽度，必须是 2 的幂且不小于 2
+     */
+    explicit CountingNetwork(unsigned network_width) : width(network_width) {
+        for (unsigned size = 2; size <= width; size *= 2) {
+            layer_masks.push_back(size - 1);
+            for (unsigned distance = size / 4; distance >= 1; distance /= 2) {
+                layer_masks.push_back(distance);
+            }
+        }
+
+        balancer_index.assign(layer_masks.size() * width, 0);
+        for (size_t layer = 0; layer < layer_masks.size(); ++layer) {
+            unsigned next_balancer = 0;
+            for (unsigned wire = 0; wire < width; ++wire) {
+                unsigned partner = wire ^ layer_masks[layer];
+                if (wire < partner) {
+                    balancer_index[layer * width + wire] = next_balancer;
+                    balancer_index[layer * width + partner] = next_balancer;
+                    ++next_balancer;
+                }
+            }
+        }
+
+        balancers = new Balancer[layer_masks.size() * (width / 2)];
+        outputs = new OutputCounter[width];
+        for (unsigned wire = 0; wire < width; ++wire) {
+            outputs[wire].next.store(wire, std::memory_order_relaxed);
+        }
+    }
+
+    ~CountingNetwork() {
+        delete[] balancers;
+        delete[] outputs;
+    }
+
+    CountingNetwork(const CountingNetwork&) = delete;
+    CountingNetwork& operator=(const CountingNetwork&) = delete;
+
+    unsigned get_width() const { return width; }
+    size_t depth() const { return layer_masks.size(); }
+
+    /**
+     * @brief 令牌从 input_wire 进入网络，返回一个从 0 开始、全局唯一的序号
+     */
+    long traverse(unsigned input_wire) {
+        unsigned wire = input_wire & (width - 1);
+        for (size_t layer = 0; layer < layer_masks.size(); ++layer) {
+            const unsigned partner = wire ^ layer_masks[layer];
+            Balancer& balancer = balancers[layer * (width / 2) + balancer_index[layer * width + wire]];
+            const unsigned toggle = balancer.toggle.fetch_add(1, std::memory_order_relaxed);
+            // 偶数次经过的令牌走上方（编号小的）输出线，奇数次走下方
+            const bool upper = (toggle & 1) == 0;
+            wire = upper ? (wire < partner ? wire : partner) : (wire < partner ? partner : wire);
+        }
+        return outputs[wire].next.fetch_add(width, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 已分发的序号个数；只有网络静止时才精确
+     */
+    long issued() const {
+        long total = 0;
+        for (unsigned wire = 0; wire < width; ++wire) {
+            total += (outputs[wire].next.load(std::memory_order_relaxed) - wire) / width;
+        }
+        return total;
+    }
+};
+
+/**
+ * @brief 计数网络后端标签
+ * @tparam Width 网络宽度（2 的幂）
+ */
+template <unsigned Width>
+struct CountingNetworkPolicy {
+    static_assert(Width >= 2 && (Width & (Width - 1)) == 0, "计数网络宽度必须是不小于 2 的 2 的幂");
+
+    static const char* name() {
+        static const std::string text = "counting-net-" + std::to_string(Width);
+        return text.c_str();
+    }
+};
+
+template <unsigned Width>
+class ThreadSafeCounter<CountingNetworkPolicy<Width>> {
+private:
+    CountingNetwork network;
+
+public:
+    ThreadSafeCounter() : network(Width) {}
+
+    ThreadSafeCounter(const ThreadSafeCounter&) = delete;
+    ThreadSafeCounter& operator=(const ThreadSafeCounter&) = delete;
+
+    static const char* name() { return CountingNetworkPolicy<Width>::name(); }
+
+    /**
+     * @brief 领取一个唯一序号；线程按自己的编号选择输入线
+     * @return 从 1 开始的唯一值，静止时已返回的值恰好是 1..n
+     */
+    int increment() { return static_cast<int>(network.traverse(thread_index()) + 1); }
+
+    /**
+     * @brief 已分发的序号个数；并发递增时为近似值，静止后精确
+     */
+    int get() const { return static_cast<int>(network.issued()); }
+};
+
+#endif // COUNTINGNETWORK_H
@@ -0,0 +1,73 @@
+#ifndef CPUUSAGE_H
+#define CPUUSAGE_H
+
+#include <cstddef>
+#include <ctime>
+#include <sys/resource.h>
+
+/**
+ * @brief 线程消耗的 CPU 时间与调度统计
+ *
+ * 墙钟吞吐量只说明跑得多快；自旋锁在超订时把等待也算成 CPU 时间，
+ * 互斥锁则以上下文切换和 futex 调用为代价让出 CPU。两者一起看，
+ * 才能比较同样的工作各自烧掉了多少 CPU。futex 调用次数由 PerfCounters 的跟踪点统计。
+ */
+struct CpuUsage {
+    long long cpu_ns = 0;                   ///< 线程 CPU 时钟，纳秒精度
+    long long user_ns = 0;                  ///< getrusage 的用户态/系统态拆分，按时钟节拍折算，短区间内会偏小
+    long long sys_ns = 0;
+    long voluntary_switches = 0;            ///< 主动让出 CPU（休眠、阻塞在 futex 上）
+    long involuntary_switches = 0;          ///< 时间片用完或被抢占
+    int threads = 0;                        ///< 合并了多少个线程，0 表示没有数据
+
+    /// 每 CPU 秒完成的操作数；没有 CPU 时间时为 0
+    double operations_per_cpu_second(std::size_t operations) const {
+        return cpu_ns > 0 ? operations * 1e9 / cpu_ns : 0.0;
+    }
+
+    void merge(const CpuUsage& other) {
+        cpu_ns += other.cpu_ns;
+        user_ns += other.user_ns;
+        sys_ns += other.sys_ns;
+        voluntary_switches += other.voluntary_switches;
+        involuntary_switches += other.involuntary_switches;
+        threads += other.threads;
+    }
+
+    /// 两次 thread_cpu_usage() 之间的增量
+    CpuUsage since(const CpuUsage& earlier) const {
+        CpuUsage delta;
+        delta.cpu_ns = cpu_ns - earlier.cpu_ns;
+        delta.user_ns = user_ns - earlier.user_ns;
+        delta.sys_ns = sys_ns - earlier.sys_ns;
+        delta.voluntary_switches = voluntary_switches - earlier.voluntary_switches;
+        delta.involuntary_switches = involuntary_switches - earlier.involuntary_switches;
+        delta.threads = 1;
+        return delta;
+    }
+};
+
+/**
+ * @brief 调用线程自创建以来的累计用量
+ *
+ * 总 CPU 时间取 CLOCK_THREAD_CPUTIME_ID；用户态/系统态拆分与上下文切换次数
+ * 取 getrusage(RUSAGE_THREAD)，前者由内核按节拍采样折算，只适合看长区间的比例。
+ */
+inline CpuUsage thread_cpu_usage() {
+    CpuUsage usage;
+    timespec now;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now) == 0) {
+        usage.cpu_ns = now.tv_sec * 1000000000ll + now.tv_nsec;
+    }
+    rusage ru;
+    if (getrusage(RUSAGE_THREAD, &ru) == 0) {
+        usage.user_ns = ru.ru_utime.tv_sec * 1000000000ll + ru.ru_utime.tv_usec * 1000ll;
+        usage.sys_ns = ru.ru_stime.tv_sec * 1000000000ll + ru.ru_stime.tv_usec * 1000ll;
+        usage.voluntary_switches = ru.ru_nvcsw;
+        usage.involuntary_switches = ru.ru_nivcsw;
+    }
+    usage.threads = 1;
+    return usage;
+}
+
+#endif // CPUUSAGE_H
@@ -0,0 +1,161 @@
+#ifndef FLATCOMBINING_H
+#define FLATCOMBINING_H
+
+#include <atomic>
+#include <type_traits>
+#include "Platform.h"
+#include "ThreadIndex.h"
+#include "ThreadSafeCounter.h"
+
+/**
+ * @brief 平面合并 (flat combining) 执行器
+ *
+ * 每个线程把请求（一个可调用对象）发布到自己的发布槽，然后争抢合并者锁；
+ * 抢到的线程成为合并者，扫描所有槽，在本线程上依次执行所有待处理请求。
+ * 受保护的 State 只被合并者访问，一次合并就处理一整批请求，
+ * 共享数据所在缓存行留在合并者的核上，而不是每次操作都在核间迁移。
+ * 没抢到锁的线程只在自己的槽上自旋，等待请求被完成。
+ *
+ * 线程编号超过 MAX_THREADS 时退化为持有合并者锁直接执行。
+ *
+ * @tparam State 被保护的状态类型
+ */
+template <typename State>
+class FlatCombiner {
+private:
+    struct alignas(CACHE_LINE_SIZE) Slot {
+        std::atomic<bool> pending{false};     ///< true 表示请求已发布、尚未完成
+        void (*invoke)(void*, State&) = nullptr;
+        void* context = nullptr;
+    };
+
+    alignas(CACHE_LINE_SIZE) std::atomic<bool> combining;
+    alignas(CACHE_LINE_SIZE) State state;
+    std::atomic<unsigned> used_slots;         ///< 曾经使用过的最大槽号 + 1，限制扫描范围
+    Slot* slots;
+
+    template <typename Fn>
+    static void invoke_request(void* context, State& s) {
+        (*static_cast<Fn*>(context))(s);
+    }
+
+    bool try_lock() {
+        return !combining.load(std::memory_order_relaxed) && !combining.exchange(true, std::memory_order_acquire);
+    }
+
+    void unlock() { combining.store(false, std::memory_order_release); }
+
+    /// 持有合并者锁时调用：执行所有已发布的请求
+    void combine() {
+        for (unsigned pass = 0; pass < COMBINE_PASSES; ++pass) {
+            const unsigned limit = used_slots.load(std::memory_order_acquire);
+            bool found = false;
+            for (unsigned i = 0; i < limit; ++i) {
+                Slot& slot = slots[i];
+                if (slot.pending.load(std::memory_order_acquire)) {
+                    slot.invoke(slot.context, state);
+                    slot.pending.store(false, std::memory_order_release);
+                    found = true;
+                }
+            }
+            if (!found) {
+                break;
+            }
+        }
+    }
+
+public:
+    /// 发布槽数量，即可同时参与合并的线程数上限
+    static constexpr unsigned MAX_THREADS = 1024;
+    /// 一次合并最多扫描的轮数
+    static constexpr unsigned COMBINE_PASSES = 3;
+
+    FlatCombiner() : combining(false), state(), used_slots(0), slots(new Slot[MAX_THREADS]) {}
+
+    ~FlatCombiner() { delete[] slots; }
+
+    FlatCombiner(const FlatCombiner&) = delete;
+    FlatCombiner& operator=(const FlatCombiner&) = delete;
+
+    /**
+     * @brief 以互斥方式执行 fn(state)，返回时 fn 已执行完毕
+     *
+     * fn 可能在合并者线程上执行，结果应通过引用捕获带回。
+     */
+    template <typename Fn>
+    void execute(Fn&& fn) {
+        typedef typename std::remove_reference<Fn>::type Request;
+        const unsigned index = thread_index();
+        if (index >= MAX_THREADS) {
+            unsigned spun = 0;
+            while (!try_lock()) {
+                spin_pause(spun);
+            }
+            fn(state);
+            combine();
+            unlock();
+            return;
+        }
+
+        Slot& slot = slots[index];
+        slot.invoke = &invoke_request<Request>;
+        slot.context = const_cast<void*>(static_cast<const void*>(&fn));
+        unsigned used = used_slots.load(std::memory_order_relaxed);
+        while (used <= index && !used_slots.compare_exchange_weak(used, index + 1, std::memory_order_release)) {
+        }
+        slot.pending.store(true, std::memory_order_release);
+
+        unsigned spun = 0;
+        for (;;) {
+            if (!slot.pending.load(std::memory_order_acquire)) {
+                return;
+            }
+            if (try_lock()) {
+                // 自己的请求在加锁前已发布，必然在本次合并中完成
+                combine();
+                unlock();
+                return;
+            }
+            spin_pause(spun);
+        }
+    }
+};
+
+/**
+ * @brief 平面合并计数器后端标签
+ */
+struct FlatCombiningPolicy {
+    static const char* name() { return "flat-combining"; }
+};
+
+template <>
+class ThreadSafeCounter<FlatCombiningPolicy> {
+private:
+    mutable FlatCombiner<int> combiner;
+
+public:
+    ThreadSafeCounter() {}
+
+    ThreadSafeCounter(const ThreadSafeCounter&) = delete;
+    ThreadSafeCounter& operator=(const ThreadSafeCounter&) = delete;
+
+    static const char* name() { return FlatCombiningPolicy::name(); }
+
+    /**
+     * @brief 递增计数器（可能由其它线程代为执行）
+     * @return 递增后的计数器值
+     */
+    int increment() {
+        int value = 0;
+        combiner.execute([&value](int& counter) { value = ++counter; });
+        return value;
+    }
+
+    int get() const {
+        int value = 0;
+        combiner.execute([&value](int& counter) { value = counter; });
+        return value;
+    }
+};
+
+#endif // FLATCOMBINING_H
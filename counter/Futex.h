@@ -0,0 +1,37 @@
+#ifndef FUTEX_H
+#define FUTEX_H
+
+#include <atomic>
+#include <climits>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/**
+ * @brief Linux futex 系统调用的薄封装（进程私有）
+ *
+ * std::atomic<int> 与 int 布局相同，直接把它的地址作为 futex 字。
+ */
+
+/**
+ * @brief 若 *word 仍等于 expected 则休眠，直到被唤醒（也可能虚假唤醒）
+ */
+inline void futex_wait(std::atomic<int>* word, int expected) {
+    syscall(SYS_futex, reinterpret_cast<int*>(word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+}
+
+/**
+ * @brief 最多唤醒 count 个在 word 上等待的线程
+ */
+inline void futex_wake(std::atomic<int>* word, int count) {
+    syscall(SYS_futex, reinterpret_cast<int*>(word), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+}
+
+/**
+ * @brief 唤醒所有在 word 上等待的线程
+ */
+inline void futex_wake_all(std::atomic<int>* word) {
+    futex_wake(word, INT_MAX);
+}
+
+#endif // FUTEX_H
@@ -0,0 +1,96 @@
+#ifndef FUTEXMUTEX_H
+#define FUTEXMUTEX_H
+
+#include <atomic>
+#include <chrono>
+#include "Platform.h"
+#include "Futex.h"
+
+/**
+ * @brief 先自旋后休眠的三态 futex 互斥锁策略，可替换 MutexPolicy (pthread_mutex_t)
+ *
+ * 状态：0 未加锁，1 已加锁且无等待者，2 已加锁且可能有等待者
+ * （Drepper《Futexes Are Tricky》中的 mutex3）。
+ *   - 无竞争时加锁/解锁各一次原子操作，不进内核；
+ *   - 竞争时先自旋 calibrated_spins() 轮，期间锁释放就直接拿走；
+ *   - 自旋失败才把状态置 2 并 FUTEX_WAIT；
+ *   - 解锁时只有状态为 2（可能有人在睡）才 FUTEX_WAKE。
+ */
+class FutexMutexPolicy {
+private:
+    std::atomic<int> state;
+
+    enum : int { UNLOCKED = 0, LOCKED = 1, CONTENDED = 2 };
+
+public:
+    /// 自旋的目标时长，约等于一次 futex 休眠+唤醒往返的代价
+    static constexpr long SPIN_TARGET_NS = 4000;
+
+    static const char* name() { return "futex"; }
+
+    /**
+     * @brief 自旋轮数：首次调用时测量 cpu_relax() 的耗时，换算成 SPIN_TARGET_NS
+     *
+     * 单 CPU 上持锁者不可能在等待者自旋时运行，自旋轮数为 0。
+     */
+    static unsigned calibrated_spins() {
+        static const unsigned spins = []() -> unsigned {
+            if (online_cpus() == 1) {
+                return 0;
+            }
+            const unsigned samples = 10000;
+            auto start = std::chrono::steady_clock::now();
+            for (unsigned i = 0; i < samples; ++i) {
+                cpu_relax();
+            }
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+            double ns_per_relax = (elapsed > 0) ? static_cast<double>(elapsed) / samples : 1.0;
+            double iterations = SPIN_TARGET_NS / ns_per_relax;
+            if (iterations < 16) {
+                iterations = 16;
+            } else if (iterations > 100000) {
+                iterations = 100000;
+            }
+            return static_cast<unsigned>(iterations);
+        }();
+        return spins;
+    }
+
+    FutexMutexPolicy() : state(UNLOCKED) {}
+
+    FutexMutexPolicy(const FutexMutexPolicy&) = delete;
+    FutexMutexPolicy& operator=(const FutexMutexPolicy&) = delete;
+
+    void lock() {
+        int expected = UNLOCKED;
+        if (state.compare_exchange_strong(expected, LOCKED, std::memory_order_acquire, std::memory_order_relaxed)) {
+            return;
+        }
+
+        const unsigned spins = calibrated_spins();
+        for (unsigned i = 0; i < spins; ++i) {
+            if (state.load(std::memory_order_relaxed) == UNLOCKED) {
+                expected = UNLOCKED;
+                if (state.compare_exchange_weak(expected, LOCKED, std::memory_order_acquire, std::memory_order_relaxed)) {
+                    return;
+                }
+            }
+            cpu_relax();
+        }
+
+        // 进入休眠路径：置为 CONTENDED，保证解锁者会唤醒我们
+        int previous = state.exchange(CONTENDED, std::memory_order_acquire);
+        while (previous != UNLOCKED) {
+            futex_wait(&state, CONTENDED);
+            previous = state.exchange(CONTENDED, std::memory_order_acquire);
+        }
+    }
+
+    void unlock() {
+        if (state.exchange(UNLOCKED, std::memory_order_release) == CONTENDED) {
+            futex_wake(&state, 1);
+        }
+    }
+};
+
+#endif // FUTEXMUTEX_H
@@ -0,0 +1,196 @@
+#ifndef IDALLOCATOR_H
+#define IDALLOCATOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Platform.h"
+#include "ThreadIndex.h"
+#include "ThreadSafeCounter.h"
+
+/**
+ * @brief 按块预留的全局唯一 ID 分配器
+ *
+ * 每个线程用一次 ThreadSafeCounter<Policy>::add(block) 预留一段连续 ID，
+ * 之后在本线程内逐个发放，共享计数器上的操作次数降为原来的 1/block。
+ * ID 互不相同，但不保证全局递增，也不保证连续。
+ *
+ * 块大小按共享计数器上的竞争自适应：每次 add(block) 都计时，分配器记录
+ * 见过的最短耗时作为无竞争基线。耗时达到基线的 CONTENDED_FACTOR 倍时说明
+ * 其他线程在争用同一个计数器，本线程块大小翻倍；不超过 UNCONTENDED_FACTOR
+ * 倍时说明没有竞争，块大小减半，减少线程手里囤积的 ID。只有一个线程在
+ * 领取时，不论领取多快，块大小都停在 min_block。
+ *
+ * 线程退出时把未发放的余量归还到共享回收池，之后任意线程预留新块前
+ * 先从池中取，因此线程退出不会丢弃 ID；永久浪费的只有分配器销毁时
+ * 仍在池中或仍在存活线程手里的余量，后者不超过 存活线程数 × max_block。
+ *
+ * @tparam Policy 底层计数器后端，需要提供 add(delta)（锁后端与 AtomicPolicy）
+ */
+template <typename Policy = AtomicPolicy>
+class BlockIdAllocator {
+private:
+    /// 连续的一段 ID：[next, end)
+    struct Range {
+        int next;
+        int end;
+    };
+
+    /// 每个线程的本地状态，只由编号对应的线程访问
+    struct alignas(CACHE_LINE_SIZE) Slot {
+        Range range{0, 0};
+        int block = 0;                      ///< 下次预留的块大小，0 表示尚未初始化
+        long refills = 0;                   ///< 本线程从共享计数器预留的次数
+        bool registered = false;            ///< 当前持有该编号的线程是否已登记退出回调
+    };
+
+    /// 可被退出回调引用的共享部分
+    struct Core : ThreadExitListener {
+        ThreadSafeCounter<Policy> source;
+        std::unique_ptr<Slot[]> slots{new Slot[MAX_THREADS]};
+        std::mutex pool_mutex;
+        std::vector<Range> pool;            ///< 退出线程归还的余量
+        std::atomic<size_t> pool_size{0};   ///< pool.size() 的无锁副本，预留时先检查它
+        std::atomic<long long> fastest_add_ns{LLONG_MAX};   ///< 见过的最短 add() 耗时，作为无竞争基线
+
+        /// 记录一次 add() 耗时，返回更新后的基线
+        long long observe_add(long long cost) {
+            long long fastest = fastest_add_ns.load(std::memory_order_relaxed);
+            while (cost < fastest && !fastest_add_ns.compare_exchange_weak(fastest, cost, std::memory_order_relaxed)) {
+            }
+            return std::min(cost, fastest);
+        }
+
+        void on_thread_exit(unsigned index) override {
+            Slot& slot = slots[index];
+            if (slot.range.next < slot.range.end) {
+                std::lock_guard<std::mutex> guard(pool_mutex);
+                pool.push_back(slot.range);
+                pool_size.store(pool.size(), std::memory_order_relaxed);
+            }
+            slot = Slot();
+        }
+
+        bool take_pooled(Range& range) {
+            if (pool_size.load(std::memory_order_relaxed) == 0) {
+                return false;
+            }
+            std::lock_guard<std::mutex> guard(pool_mutex);
+            if (pool.empty()) {
+                return false;
+            }
+            range = pool.back();
+            pool.pop_back();
+            pool_size.store(pool.size(), std::memory_order_relaxed);
+            return true;
+        }
+    };
+
+    std::shared_ptr<Core> owner;
+    Core* core;                             ///< owner.get()，热路径上省去一次间接
+    int min_block;
+    int max_block;
+
+    static long long now_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /// 慢路径：本地区间用完，取新区间；从共享计数器预留时按这次 add() 的耗时调整下次的块大小
+    int refill(Slot& slot) {
+        if (!slot.registered) {
+            ThreadExitHooks::local().add(owner);
+            slot.registered = true;
+            slot.block = min_block;
+        }
+
+        if (!core->take_pooled(slot.range)) {
+            const long long start = now_ns();
+            const int end = core->source.add(slot.block) + 1;
+            const long long cost = now_ns() - start;
+            slot.range = Range{end - slot.block, end};
+            ++slot.refills;
+
+            // 时钟分辨率不足时 cost 可能为 0，基线至少取 1 ns
+            const long long baseline = std::max(core->observe_add(cost), 1LL);
+            if (cost >= CONTENDED_FACTOR * baseline) {
+                slot.block = std::min(slot.block * 2, max_block);
+            } else if (cost <= UNCONTENDED_FACTOR * baseline) {
+                slot.block = std::max(slot.block / 2, min_block);
+            }
+        }
+        return slot.range.next++;
+    }
+
+public:
+    /// 本地状态槽数量；编号超过该值的线程每次都直接递增共享计数器
+    static constexpr unsigned MAX_THREADS = 1024;
+    /// add() 耗时达到无竞争基线的该倍数时视为有竞争，块大小翻倍
+    static constexpr long long CONTENDED_FACTOR = 4;
+    /// add() 耗时不超过无竞争基线的该倍数时视为无竞争，块大小减半；介于两者之间时不变
+    static constexpr long long UNCONTENDED_FACTOR = 2;
+
+    /**
+     * @param min_block_size 块大小下限，线程第一次预留时使用
+     * @param max_block_size 块大小上限，也是每个存活线程最多囤积的 ID 数
+     */
+    explicit BlockIdAllocator(int min_block_size = 16, int max_block_size = 4096)
+        : owner(std::make_shared<Core>()), core(owner.get()),
+          min_block(std::max(min_block_size, 1)), max_block(std::max(max_block_size, std::max(min_block_size, 1))) {}
+
+    BlockIdAllocator(const BlockIdAllocator&) = delete;
+    BlockIdAllocator& operator=(const BlockIdAllocator&) = delete;
+
+    static const char* name() {
+        static const std::string text = std::string("block-id-") + Policy::name();
+        return text.c_str();
+    }
+
+    /**
+     * @brief 领取一个 ID
+     * @return 从 1 开始、在本分配器内唯一的 ID
+     */
+    int next() {
+        const unsigned index = thread_index();
+        if (index >= MAX_THREADS) {
+            return core->source.increment();
+        }
+        Slot& slot = core->slots[index];
+        if (slot.range.next < slot.range.end) {
+            return slot.range.next++;
+        }
+        return refill(slot);
+    }
+
+    /// 当前线程下次预留的块大小（尚未领取过 ID 时为 0）
+    int block_size() const {
+        const unsigned index = thread_index();
+        return index < MAX_THREADS ? core->slots[index].block : 1;
+    }
+
+    /// 已从共享计数器预留的 ID 总数（含已发放、囤积在线程手里和回收池中的）
+    int reserved() const { return core->source.get(); }
+
+    /// 当前线程从共享计数器预留的次数
+    long thread_refills() const {
+        const unsigned index = thread_index();
+        return index < MAX_THREADS ? core->slots[index].refills : 0;
+    }
+
+    /// 回收池中尚未再次发放的 ID 数
+    long pooled() const {
+        std::lock_guard<std::mutex> guard(core->pool_mutex);
+        long total = 0;
+        for (const Range& range : core->pool) {
+            total += range.end - range.next;
+        }
+        return total;
+    }
+};
+
+#endif // IDALLOCATOR_H
@@ -0,0 +1,146 @@
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 延迟直方图的百分位摘要，单位纳秒；samples 为 0 表示未测量
+ */
+struct LatencySummary {
+    unsigned long samples = 0;
+    std::uint64_t p50 = 0;
+    std::uint64_t p90 = 0;
+    std::uint64_t p99 = 0;
+    std::uint64_t p999 = 0;
+    std::uint64_t max = 0;
+};
+
+/**
+ * @brief HDR 风格的对数分桶延迟直方图（纳秒）
+ *
+ * 每个 2 的幂区间再线性分成 2^SUB_BUCKET_BITS 个桶，相对误差不超过
+ * 1/2^SUB_BUCKET_BITS（约 3%），覆盖整个 64 位取值范围只需 1920 个桶。
+ * record() 只是一次下标计算加一次普通自增，不做任何同步：
+ * 每个线程各记一份，结束后用 merge() 合并。
+ */
+class LatencyHistogram {
+private:
+    static constexpr unsigned SUB_BUCKET_BITS = 5;
+    static constexpr unsigned SUB_BUCKETS = 1u << SUB_BUCKET_BITS;
+    static constexpr unsigned BUCKETS = (64 - SUB_BUCKET_BITS) * SUB_BUCKETS + SUB_BUCKETS;
+
+    std::vector<unsigned long> counts;
+    unsigned long total;
+    std::uint64_t max_value;
+
+    static unsigned bucket_of(std::uint64_t value) {
+        if (value < SUB_BUCKETS) {
+            return static_cast<unsigned>(value);
+        }
+        const unsigned shift = (63 - __builtin_clzll(value)) - SUB_BUCKET_BITS;
+        return (shift << SUB_BUCKET_BITS) + static_cast<unsigned>(value >> shift);
+    }
+
+    /// 桶内的最大值（HDR 的 highest equivalent value）
+    static std::uint64_t bucket_upper(unsigned bucket) {
+        if (bucket < 2 * SUB_BUCKETS) {
+            return bucket;
+        }
+        const unsigned shift = (bucket >> SUB_BUCKET_BITS) - 1;
+        const std::uint64_t sub = (bucket & (SUB_BUCKETS - 1)) + SUB_BUCKETS;
+        return ((sub + 1) << shift) - 1;
+    }
+
+public:
+    LatencyHistogram() : counts(BUCKETS, 0), total(0), max_value(0) {}
+
+    void record(std::uint64_t value_ns) {
+        ++counts[bucket_of(value_ns)];
+        ++total;
+        max_value = std::max(max_value, value_ns);
+    }
+
+    void merge(const LatencyHistogram& other) {
+        for (unsigned i = 0; i < BUCKETS; ++i) {
+            counts[i] += other.counts[i];
+        }
+        total += other.total;
+        max_value = std::max(max_value, other.max_value);
+    }
+
+    unsigned long count() const { return total; }
+    std::uint64_t max() const { return max_value; }
+
+    /**
+     * @brief 第 percent 百分位的值（桶上界，不超过记录到的最大值）；没有样本时为 0
+     */
+    std::uint64_t percentile(double percent) const {
+        if (total == 0) {
+            return 0;
+        }
+        unsigned long rank = static_cast<unsigned long>(percent / 100.0 * total + 0.5);
+        rank = std::max(1ul, std::min(rank, total));
+        unsigned long seen = 0;
+        for (unsigned i = 0; i < BUCKETS; ++i) {
+            seen += counts[i];
+            if (seen >= rank) {
+                return std::min(bucket_upper(i), max_value);
+            }
+        }
+        return max_value;
+    }
+
+    LatencySummary summary() const {
+        LatencySummary result;
+        result.samples = total;
+        result.p50 = percentile(50.0);
+        result.p90 = percentile(90.0);
+        result.p99 = percentile(99.0);
+        result.p999 = percentile(99.9);
+        result.max = max_value;
+        return result;
+    }
+};
+
+/**
+ * @brief 一次空计时（连续两次读 steady_clock）的耗时中位数，首次调用时测量
+ *
+ * 每个延迟样本都减去它，得到操作本身的耗时；减完为负时记为 0。
+ */
+inline std::uint64_t timer_overhead_ns() {
+    static const std::uint64_t overhead = []() {
+        const int samples = 10001;
+        std::vector<long long> durations(samples);
+        for (int i = 0; i < samples; ++i) {
+            const auto begin = std::chrono::steady_clock::now();
+            const auto end = std::chrono::steady_clock::now();
+            durations[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+        }
+        std::nth_element(durations.begin(), durations.begin() + samples / 2, durations.end());
+        return static_cast<std::uint64_t>(std::max(0ll, durations[samples / 2]));
+    }();
+    return overhead;
+}
+
+/**
+ * @brief 执行 op() 并把扣除计时开销后的耗时记入 histogram，返回 op() 的结果
+ */
+template <typename Op>
+inline auto timed_operation(LatencyHistogram& histogram, Op&& op) -> decltype(op()) {
+    struct Recorder {
+        LatencyHistogram& histogram;
+        std::chrono::steady_clock::time_point begin;
+        ~Recorder() {
+            const long long elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - begin).count();
+            const std::uint64_t overhead = timer_overhead_ns();
+            histogram.record(elapsed > static_cast<long long>(overhead) ? elapsed - overhead : 0);
+        }
+    } recorder{histogram, std::chrono::steady_clock::now()};
+    return op();
+}
+
+#endif // LATENCYHISTOGRAM_H
@@ -0,0 +1,89 @@
+#ifndef LOCKPOLICIES_H
+#define LOCKPOLICIES_H
+
+#include <pthread.h>
+#include <iostream>
+#include "Platform.h"
+
+/**
+ * @brief 锁策略：ThreadSafeCounter<LockPolicy> 的模板参数
+ *
+ * 每个锁策略需要提供：
+ *   - static const char* name()  后端名称，用于测试输出
+ *   - void lock() / void unlock()
+ *   - 可选：void lock_shared() / void unlock_shared()，提供时 get() 使用读锁
+ *   - 可选：bool try_lock()，提供时锁剖析 (LockProfiling.h) 用它判断加锁是否遇到竞争
+ * 所有成员函数都在头文件内定义，保证 increment() 热路径可以被完全内联。
+ */
+
+/**
+ * @brief 基于 pthread_mutex_t 的互斥锁策略（对应 Mutex/ 目录）
+ */
+class MutexPolicy {
+private:
+    pthread_mutex_t mutex;
+
+public:
+    static const char* name() { return "mutex"; }
+
+    MutexPolicy() {
+        if (pthread_mutex_init(&mutex, nullptr) != 0) {
+            std::cerr << "互斥锁初始化失败" << std::endl;
+        }
+    }
+
+    ~MutexPolicy() {
+        if (pthread_mutex_destroy(&mutex) != 0) {
+            std::cerr << "互斥锁销毁失败" << std::endl;
+        }
+    }
+
+    MutexPolicy(const MutexPolicy&) = delete;
+    MutexPolicy& operator=(const MutexPolicy&) = delete;
+
+    void lock() { pthread_mutex_lock(&mutex); }
+    bool try_lock() { return pthread_mutex_trylock(&mutex) == 0; }
+    void unlock() { pthread_mutex_unlock(&mutex); }
+};
+
+/**
+ * @brief 基于 pthread_spinlock_t 的自旋锁策略（对应 spin_lock/ 目录）
+ */
+class SpinLockPolicy {
+private:
+    pthread_spinlock_t spin;
+
+public:
+    static const char* name() { return "spinlock"; }
+
+    SpinLockPolicy() {
+        if (pthread_spin_init(&spin, PTHREAD_PROCESS_PRIVATE) != 0) {
+            std::cerr << "自旋锁初始化失败" << std::endl;
+        }
+    }
+
+    ~SpinLockPolicy() {
+        if (pthread_spin_destroy(&spin) != 0) {
+            std::cerr << "自旋锁销毁失败" << std::endl;
+        }
+    }
+
+    SpinLockPolicy(const SpinLockPolicy&) = delete;
+    SpinLockPolicy& operator=(const SpinLockPolicy&) = delete;
+
+    void lock() {
+#ifdef COUNTER_LOCK_PROFILING
+        // 剖析时改用 trylock 循环，才能数出自旋轮数
+        while (pthread_spin_trylock(&spin) != 0) {
+            cpu_relax();
+        }
+#else
+        pthread_spin_lock(&spin);
+#endif
+    }
+
+    bool try_lock() { return pthread_spin_trylock(&spin) == 0; }
+    void unlock() { pthread_spin_unlock(&spin); }
+};
+
+#endif // LOCKPOLICIES_H
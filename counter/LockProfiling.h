@@ -0,0 +1,336 @@
+#ifndef LOCKPROFILING_H
+#define LOCKPROFILING_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "Platform.h"
+#include "ThreadIndex.h"
+
+/**
+ * @brief 锁竞争剖析（编译期开关 COUNTER_LOCK_PROFILING）
+ *
+ * 定义 COUNTER_LOCK_PROFILING 后，基于锁的 ThreadSafeCounter 把锁策略包装成
+ * ProfiledLock<LockPolicy>，记录每把锁的获取次数、竞争次数、等待与持有时间
+ * （总计与最大值）以及自旋轮数；未定义时包装层完全不存在，没有任何开销。
+ *
+ * 统计数据按线程编号分片，每片独占缓存行，加锁路径只写本线程的分片；
+ * 只有读取剖析结果时才汇总所有分片。自旋轮数来自 Platform.h 的
+ * cpu_relax()/spin_pause()，pthread_mutex 在内核中等待，不计自旋。
+ */
+
+/**
+ * @brief 一把锁的剖析结果，时间单位为纳秒
+ */
+struct LockProfile {
+    std::string name;
+    unsigned long acquisitions = 0;
+    unsigned long contended = 0;        ///< 加锁时锁已被占用的次数
+    unsigned long spins = 0;
+    unsigned long long wait_total_ns = 0;
+    unsigned long long wait_max_ns = 0;
+    unsigned long long hold_total_ns = 0;
+    unsigned long long hold_max_ns = 0;
+};
+
+/**
+ * @brief 可被 LockProfiler 汇总的剖析数据源
+ */
+class LockProfileSource {
+public:
+    virtual ~LockProfileSource() {}
+    virtual LockProfile profile() const = 0;
+    virtual void reset() = 0;
+};
+
+/**
+ * @brief 全局剖析登记表：记录所有存活的剖析锁，以及已销毁锁的最终结果
+ */
+class LockProfiler {
+private:
+    mutable std::mutex mutex;
+    std::unordered_set<LockProfileSource*> live;
+    std::vector<LockProfile> retired;
+
+public:
+    static LockProfiler& instance() {
+        static LockProfiler profiler;
+        return profiler;
+    }
+
+    void attach(LockProfileSource* source) {
+        std::lock_guard<std::mutex> guard(mutex);
+        live.insert(source);
+    }
+
+    /// 锁销毁时调用，保留它的结果直到下一次 reset()
+    void detach(LockProfileSource* source) {
+        LockProfile final_profile = source->profile();
+        std::lock_guard<std::mutex> guard(mutex);
+        live.erase(source);
+        if (final_profile.acquisitions > 0) {
+            retired.push_back(std::move(final_profile));
+        }
+    }
+
+    /// 所有获取次数非零的锁的剖析结果，已销毁的在前
+    std::vector<LockProfile> collect() const {
+        std::lock_guard<std::mutex> guard(mutex);
+        std::vector<LockProfile> result = retired;
+        for (const LockProfileSource* source : live) {
+            LockProfile profile = source->profile();
+            if (profile.acquisitions > 0) {
+                result.push_back(std::move(profile));
+            }
+        }
+        return result;
+    }
+
+    /// 清空所有统计：丢弃已销毁锁的结果，存活锁的分片清零
+    void reset() {
+        std::lock_guard<std::mutex> guard(mutex);
+        retired.clear();
+        for (LockProfileSource* source : live) {
+            source->reset();
+        }
+    }
+
+    /// 以表格形式输出 collect() 的结果
+    void dump(std::ostream& out) const {
+        const std::vector<LockProfile> profiles = collect();
+        if (profiles.empty()) {
+            return;
+        }
+        out << "--- 锁竞争剖析 ---" << std::endl;
+        out << std::setw(16) << "锁" << std::setw(12) << "获取" << std::setw(10) << "竞争%"
+            << std::setw(12) << "平均等待ns" << std::setw(12) << "最大等待ns"
+            << std::setw(12) << "平均持有ns" << std::setw(12) << "最大持有ns" << std::setw(14) << "自旋轮数" << std::endl;
+        for (const LockProfile& p : profiles) {
+            const double n = static_cast<double>(p.acquisitions);
+            out << std::setw(16) << p.name << std::setw(12) << p.acquisitions
+                << std::setw(10) << std::fixed << std::setprecision(2) << 100.0 * p.contended / n
+                << std::setw(12) << std::setprecision(0) << p.wait_total_ns / n << std::setw(12) << p.wait_max_ns
+                << std::setw(12) << p.hold_total_ns / n << std::setw(12) << p.hold_max_ns
+                << std::setw(14) << p.spins << std::endl;
+        }
+    }
+};
+
+/**
+ * @brief 检测锁策略是否提供 try_lock()
+ */
+template <typename Lock, typename = void>
+struct has_try_lock : std::false_type {};
+
+template <typename Lock>
+struct has_try_lock<Lock, std::void_t<decltype(std::declval<Lock&>().try_lock())>> : std::true_type {};
+
+/**
+ * @brief 给锁策略加上剖析统计的包装层，接口与被包装的策略相同
+ *
+ * 提供 try_lock() 的策略先试一次，失败即计为竞争；否则等待超过
+ * CONTENDED_WAIT_NS 或期间有自旋时计为竞争。
+ */
+template <typename Lock>
+class ProfiledLock : public LockProfileSource {
+private:
+    struct alignas(CACHE_LINE_SIZE) Shard {
+        std::atomic<unsigned long> acquisitions{0};
+        std::atomic<unsigned long> contended{0};
+        std::atomic<unsigned long> spins{0};
+        std::atomic<unsigned long long> wait_total_ns{0};
+        std::atomic<unsigned long long> wait_max_ns{0};
+        std::atomic<unsigned long long> hold_total_ns{0};
+        std::atomic<unsigned long long> hold_max_ns{0};
+        std::atomic<long long> shared_hold_start{0};    ///< 本线程持有读锁的起始时刻
+    };
+
+    Lock inner;
+    long long hold_start;               ///< 写锁持有者的加锁时刻，受锁本身保护
+    std::atomic<Shard*>* shards;
+
+    static long long now_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    static unsigned long spin_count() {
+#ifdef COUNTER_LOCK_PROFILING
+        return profiled_spin_count();
+#else
+        return 0;
+#endif
+    }
+
+    static void update_max(std::atomic<unsigned long long>& target, unsigned long long value) {
+        unsigned long long current = target.load(std::memory_order_relaxed);
+        while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    /// 当前线程的分片；编号超过 MAX_SHARDS 的线程与其它线程共用分片
+    Shard& local_shard() {
+        std::atomic<Shard*>& slot = shards[thread_index() % MAX_SHARDS];
+        Shard* shard = slot.load(std::memory_order_acquire);
+        if (shard == nullptr) {
+            Shard* created = new Shard();
+            if (slot.compare_exchange_strong(shard, created, std::memory_order_acq_rel)) {
+                shard = created;
+            } else {
+                delete created;
+            }
+        }
+        return *shard;
+    }
+
+    /// 加锁完成后记录一次获取，返回获取完成的时刻
+    long long record_acquire(Shard& shard, long long start, unsigned long spins_before, bool contended) {
+        const long long acquired = now_ns();
+        const unsigned long spins = spin_count() - spins_before;
+        const unsigned long long wait = static_cast<unsigned long long>(acquired - start);
+        if (!contended) {
+            contended = spins > 0 || wait > CONTENDED_WAIT_NS;
+        }
+        shard.acquisitions.fetch_add(1, std::memory_order_relaxed);
+        if (contended) {
+            shard.contended.fetch_add(1, std::memory_order_relaxed);
+        }
+        shard.spins.fetch_add(spins, std::memory_order_relaxed);
+        shard.wait_total_ns.fetch_add(wait, std::memory_order_relaxed);
+        update_max(shard.wait_max_ns, wait);
+        return acquired;
+    }
+
+    void record_release(Shard& shard, long long acquired) {
+        const unsigned long long hold = static_cast<unsigned long long>(now_ns() - acquired);
+        shard.hold_total_ns.fetch_add(hold, std::memory_order_relaxed);
+        update_max(shard.hold_max_ns, hold);
+    }
+
+public:
+    /// 分片数量
+    static constexpr unsigned MAX_SHARDS = 256;
+    /// 没有 try_lock() 的策略，等待超过该值计为一次竞争
+    static constexpr unsigned long long CONTENDED_WAIT_NS = 1000;
+
+    static const char* name() { return Lock::name(); }
+
+    ProfiledLock() : hold_start(0), shards(new std::atomic<Shard*>[MAX_SHARDS]) {
+        for (unsigned i = 0; i < MAX_SHARDS; ++i) {
+            shards[i].store(nullptr, std::memory_order_relaxed);
+        }
+        LockProfiler::instance().attach(this);
+    }
+
+    ~ProfiledLock() override {
+        LockProfiler::instance().detach(this);
+        for (unsigned i = 0; i < MAX_SHARDS; ++i) {
+            delete shards[i].load(std::memory_order_relaxed);
+        }
+        delete[] shards;
+    }
+
+    ProfiledLock(const ProfiledLock&) = delete;
+    ProfiledLock& operator=(const ProfiledLock&) = delete;
+
+    /// 被包装的锁策略，用于读取策略自带的统计信息
+    const Lock& policy() const { return inner; }
+
+    void lock() {
+        Shard& shard = local_shard();
+        const unsigned long spins_before = spin_count();
+        const long long start = now_ns();
+        bool contended = false;
+        if constexpr (has_try_lock<Lock>::value) {
+            if (!inner.try_lock()) {
+                contended = true;
+                inner.lock();
+            }
+        } else {
+            inner.lock();
+        }
+        hold_start = record_acquire(shard, start, spins_before, contended);
+    }
+
+    void unlock() {
+        record_release(local_shard(), hold_start);
+        inner.unlock();
+    }
+
+    void lock_shared() {
+        Shard& shard = local_shard();
+        const unsigned long spins_before = spin_count();
+        const long long start = now_ns();
+        inner.lock_shared();
+        shard.shared_hold_start.store(record_acquire(shard, start, spins_before, false), std::memory_order_relaxed);
+    }
+
+    void unlock_shared() {
+        Shard& shard = local_shard();
+        record_release(shard, shard.shared_hold_start.load(std::memory_order_relaxed));
+        inner.unlock_shared();
+    }
+
+    LockProfile profile() const override {
+        LockProfile result;
+        result.name = Lock::name();
+        for (unsigned i = 0; i < MAX_SHARDS; ++i) {
+            const Shard* shard = shards[i].load(std::memory_order_acquire);
+            if (shard == nullptr) {
+                continue;
+            }
+            result.acquisitions += shard->acquisitions.load(std::memory_order_relaxed);
+            result.contended += shard->contended.load(std::memory_order_relaxed);
+            result.spins += shard->spins.load(std::memory_order_relaxed);
+            result.wait_total_ns += shard->wait_total_ns.load(std::memory_order_relaxed);
+            result.wait_max_ns = std::max(result.wait_max_ns, shard->wait_max_ns.load(std::memory_order_relaxed));
+            result.hold_total_ns += shard->hold_total_ns.load(std::memory_order_relaxed);
+            result.hold_max_ns = std::max(result.hold_max_ns, shard->hold_max_ns.load(std::memory_order_relaxed));
+        }
+        return result;
+    }
+
+    void reset() override {
+        for (unsigned i = 0; i < MAX_SHARDS; ++i) {
+            Shard* shard = shards[i].load(std::memory_order_acquire);
+            if (shard == nullptr) {
+                continue;
+            }
+            shard->acquisitions.store(0, std::memory_order_relaxed);
+            shard->contended.store(0, std::memory_order_relaxed);
+            shard->spins.store(0, std::memory_order_relaxed);
+            shard->wait_total_ns.store(0, std::memory_order_relaxed);
+            shard->wait_max_ns.store(0, std::memory_order_relaxed);
+            shard->hold_total_ns.store(0, std::memory_order_relaxed);
+            shard->hold_max_ns.store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+/**
+ * @brief ThreadSafeCounter 实际持有的锁类型：开启剖析时为包装层，否则就是策略本身
+ */
+#ifdef COUNTER_LOCK_PROFILING
+template <typename Lock>
+using CounterLock = ProfiledLock<Lock>;
+#else
+template <typename Lock>
+using CounterLock = Lock;
+#endif
+
+/// 取出被包装的锁策略；未包装时原样返回
+template <typename Lock>
+const Lock& unwrap_lock(const Lock& lock) { return lock; }
+
+template <typename Lock>
+const Lock& unwrap_lock(const ProfiledLock<Lock>& lock) { return lock.policy(); }
+
+#endif // LOCKPROFILING_H
@@ -0,0 +1,233 @@
+#ifndef PARKINGLOT_H
+#define PARKINGLOT_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "Platform.h"
+#include "Futex.h"
+#include "FutexMutex.h"
+
+/**
+ * @brief WebKit/Rust 风格的全局停车场 (parking lot)
+ *
+ * 锁本身只保存几个状态位，等待队列不放在锁里，而是放在一张以锁地址为键的
+ * 全局哈希表中。每个线程有一个线程局部的 ThreadData，休眠时挂到对应桶的
+ * 队列上，在自己的 futex 字上等待。桶数固定为 NUM_BUCKETS，同一个桶里
+ * 可能混有多个地址的等待者，按地址过滤。
+ */
+namespace parking_lot {
+
+/**
+ * @brief 每个线程一个，park 时挂到桶队列上
+ *
+ * 被唤醒的线程一看到 parked 变为 0 就可能返回并退出，而唤醒者此时还要对
+ * parked 做 futex_wake，因此 ThreadData 放在堆上按引用计数释放：线程自己
+ * 持有一份，unpark_one 在唤醒期间持有一份，最后一个放手的负责 delete。
+ */
+struct ThreadData {
+    std::atomic<int> parked{0};       ///< futex 字：1 表示正在休眠
+    const void* address = nullptr;    ///< 正在等待的地址
+    ThreadData* next = nullptr;
+    std::atomic<int> references{1};
+
+    void retain() { references.fetch_add(1, std::memory_order_relaxed); }
+
+    void release() {
+        if (references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete this;
+        }
+    }
+};
+
+inline ThreadData& this_thread_data() {
+    struct Holder {
+        ThreadData* data = new ThreadData;
+        ~Holder() { data->release(); }
+    };
+    thread_local Holder holder;
+    return *holder.data;
+}
+
+struct alignas(CACHE_LINE_SIZE) Bucket {
+    FutexMutexPolicy lock;
+    ThreadData* head = nullptr;
+    ThreadData* tail = nullptr;
+};
+
+/// 桶数（2 的幂）
+constexpr std::size_t NUM_BUCKETS = 1024;
+
+inline Bucket& bucket_for(const void* address) {
+    static Bucket buckets[NUM_BUCKETS];
+    // 斐波那契哈希，取高位作为桶号
+    std::uint64_t hash = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(address)) * 0x9E3779B97F4A7C15ull;
+    return buckets[hash >> (64 - 10)];
+}
+static_assert(NUM_BUCKETS == (std::size_t(1) << 10), "bucket_for 取 hash 高 10 位");
+
+/**
+ * @brief 在 address 上休眠
+ *
+ * 持有桶锁时调用 validate()，返回 false 则不休眠直接返回 false；
+ * 否则入队、释放桶锁并休眠，直到被 unpark_one 唤醒后返回 true。
+ */
+template <typename Validate>
+bool park(const void* address, Validate validate) {
+    ThreadData& me = this_thread_data();
+    Bucket& bucket = bucket_for(address);
+
+    bucket.lock.lock();
+    if (!validate()) {
+        bucket.lock.unlock();
+        return false;
+    }
+    me.address = address;
+    me.next = nullptr;
+    me.parked.store(1, std::memory_order_relaxed);
+    if (bucket.tail != nullptr) {
+        bucket.tail->next = &me;
+    } else {
+        bucket.head = &me;
+    }
+    bucket.tail = &me;
+    bucket.lock.unlock();
+
+    while (me.parked.load(std::memory_order_acquire) == 1) {
+        futex_wait(&me.parked, 1);
+    }
+    return true;
+}
+
+struct UnparkResult {
+    bool unparked_thread;             ///< 是否唤醒了一个线程
+    bool may_have_more_threads;       ///< 队列中是否还有等待同一地址的线程
+};
+
+/**
+ * @brief 唤醒一个在 address 上休眠的线程（FIFO）
+ *
+ * 持有桶锁时以 UnparkResult 调用 callback，让锁在同一临界区内
+ * 根据是否还有等待者更新自己的状态位。
+ */
+template <typename Callback>
+void unpark_one(const void* address, Callback callback) {
+    Bucket& bucket = bucket_for(address);
+
+    bucket.lock.lock();
+    ThreadData* previous = nullptr;
+    ThreadData* found = bucket.head;
+    while (found != nullptr && found->address != address) {
+        previous = found;
+        found = found->next;
+    }
+
+    bool more = false;
+    if (found != nullptr) {
+        ThreadData* after = found->next;
+        if (previous != nullptr) {
+            previous->next = after;
+        } else {
+            bucket.head = after;
+        }
+        if (bucket.tail == found) {
+            bucket.tail = previous;
+        }
+        // 在 parked 清零之前取得引用，等待者在此之前不会返回
+        found->retain();
+        for (ThreadData* p = after; p != nullptr; p = p->next) {
+            if (p->address == address) {
+                more = true;
+                break;
+            }
+        }
+    }
+    callback(UnparkResult{found != nullptr, more});
+    bucket.lock.unlock();
+
+    if (found != nullptr) {
+        found->parked.store(0, std::memory_order_release);
+        futex_wake(&found->parked, 1);
+        found->release();
+    }
+}
+
+} // namespace parking_lot
+
+/**
+ * @brief 只占一个字节的锁策略，等待者停在全局停车场
+ *
+ * bit0 表示已加锁，bit1 表示停车场里可能有等待者。无竞争时加锁/解锁
+ * 各一次字节 CAS；竞争时先短暂自旋，再置 PARKED 位并 park；解锁发现
+ * PARKED 位时唤醒一个等待者，并按队列是否还有人决定是否保留 PARKED 位。
+ * 允许插队（被唤醒者需要重新竞争），与 WebKit Lock 相同。
+ */
+class ParkingLotPolicy {
+private:
+    std::atomic<std::uint8_t> bits;
+
+    static constexpr std::uint8_t LOCKED_BIT = 1;
+    static constexpr std::uint8_t PARKED_BIT = 2;
+
+    void lock_slow() {
+        unsigned spins = 0;
+        for (;;) {
+            std::uint8_t current = bits.load(std::memory_order_relaxed);
+            if (!(current & LOCKED_BIT)) {
+                if (bits.compare_exchange_weak(current, current | LOCKED_BIT, std::memory_order_acquire, std::memory_order_relaxed)) {
+                    return;
+                }
+                continue;
+            }
+            // 还没有人停车时先自旋一小会儿（单 CPU 上自旋无意义）
+            if (!(current & PARKED_BIT) && spins < SPIN_LIMIT && online_cpus() > 1) {
+                ++spins;
+                cpu_relax();
+                continue;
+            }
+            if (!(current & PARKED_BIT)) {
+                if (!bits.compare_exchange_weak(current, current | PARKED_BIT, std::memory_order_relaxed)) {
+                    continue;
+                }
+            }
+            parking_lot::park(&bits, [this]() {
+                return bits.load(std::memory_order_relaxed) == (LOCKED_BIT | PARKED_BIT);
+            });
+        }
+    }
+
+    void unlock_slow() {
+        parking_lot::unpark_one(&bits, [this](parking_lot::UnparkResult result) {
+            bits.store(result.may_have_more_threads ? PARKED_BIT : 0, std::memory_order_release);
+        });
+    }
+
+public:
+    /// 停车前的最大自旋轮数
+    static constexpr unsigned SPIN_LIMIT = 40;
+
+    static const char* name() { return "parkinglot"; }
+
+    ParkingLotPolicy() : bits(0) {}
+
+    ParkingLotPolicy(const ParkingLotPolicy&) = delete;
+    ParkingLotPolicy& operator=(const ParkingLotPolicy&) = delete;
+
+    void lock() {
+        std::uint8_t expected = 0;
+        if (!bits.compare_exchange_weak(expected, LOCKED_BIT, std::memory_order_acquire, std::memory_order_relaxed)) {
+            lock_slow();
+        }
+    }
+
+    void unlock() {
+        std::uint8_t expected = LOCKED_BIT;
+        if (!bits.compare_exchange_strong(expected, 0, std::memory_order_release, std::memory_order_relaxed)) {
+            unlock_slow();
+        }
+    }
+};
+
+static_assert(sizeof(ParkingLotPolicy) == 1, "ParkingLotPolicy 应只占一个字节");
+
+#endif // PARKINGLOT_H
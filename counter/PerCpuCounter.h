@@ -0,0 +1,198 @@
+#ifndef PERCPUCOUNTER_H
+#define PERCPUCOUNTER_H
+
+#include <atomic>
+#include <cerrno>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <sys/sysinfo.h>
+#include "Platform.h"
+#include "ThreadSafeCounter.h"
+
+// rseq 临界区目前只实现了 x86-64 版本；其它架构或缺少 <sys/rseq.h> 时只编译回退路径
+#if defined(__x86_64__) && defined(__has_include)
+#if __has_include(<sys/rseq.h>)
+#include <sys/rseq.h>
+#define COUNTER_HAVE_RSEQ 1
+#endif
+#endif
+
+/**
+ * @brief 基于 Linux 可重启序列 (rseq) 的每 CPU 计数器后端标签
+ *
+ * increment() 在 rseq 临界区内对当前 CPU 的槽位做一条普通的 addq，
+ * 热路径上没有带 lock 前缀的指令；线程在临界区内被抢占或迁移时内核
+ * 让它跳到 abort 处重试。get() 对所有 CPU 槽位求和。
+ *
+ * rseq 不可用（内核过旧、注册失败、非 x86-64）时回退为对
+ * sched_getcpu() 槽位做 fetch_add，仍然按 CPU 分散竞争。
+ */
+struct PerCpuPolicy {
+    static const char* name();
+};
+
+namespace percpu_detail {
+
+#ifdef COUNTER_HAVE_RSEQ
+/// x86 上 glibc 与内核自测使用的 rseq 签名，abort 处理函数前必须有它
+constexpr unsigned RSEQ_SIGNATURE = 0x53053053;
+
+/**
+ * @brief 取当前线程的 struct rseq；glibc 未注册时自行注册，失败返回 nullptr
+ */
+inline struct rseq* thread_rseq() {
+    // 0: 未检查，1: 可用，2: 不可用
+    thread_local int state = 0;
+    thread_local struct rseq* area = nullptr;
+    alignas(32) thread_local struct rseq own_area;
+
+    if (state == 0) {
+        if (__rseq_size > 0) {
+            area = reinterpret_cast<struct rseq*>(static_cast<char*>(__builtin_thread_pointer()) + __rseq_offset);
+        } else {
+            own_area.cpu_id = RSEQ_CPU_ID_UNINITIALIZED;
+            if (syscall(SYS_rseq, &own_area, sizeof(own_area), 0, RSEQ_SIGNATURE) == 0) {
+                area = &own_area;
+            }
+        }
+        state = (area != nullptr && static_cast<int>(area->cpu_id) >= 0) ? 1 : 2;
+    }
+    return state == 1 ? area : nullptr;
+}
+
+/**
+ * @brief 若当前仍运行在 cpu 上，则以不可中断的方式执行 *slot += 1
+ * @return 提交成功返回 true；被抢占、迁移或收到信号时返回 false
+ */
+inline bool rseq_add_one(struct rseq* rs, long* slot, int cpu) {
+    __asm__ __volatile__ goto (
+        ".pushsection __rseq_cs, \"aw\"\n\t"
+        ".balign 32\n\t"
+        "3:\n\t"
+        ".long 0x0, 0x0\n\t"                        // version, flags
+        ".quad 1f, (2f - 1f), 4f\n\t"               // start_ip, post_commit_offset, abort_ip
+        ".popsection\n\t"
+        ".pushsection __rseq_cs_ptr_array, \"aw\"\n\t"
+        ".quad 3b\n\t"
+        ".popsection\n\t"
+        "leaq 3b(%%rip), %%rax\n\t"
+        "movq %%rax, %[rseq_cs]\n\t"                // 进入临界区
+        "1:\n\t"
+        "cmpl %[cpu], %[current_cpu]\n\t"
+        "jnz 4f\n\t"
+        "addq $1, %[slot]\n\t"                      // 提交
+        "2:\n\t"
+        ".pushsection __rseq_failure, \"ax\"\n\t"
+        ".byte 0x0f, 0xb9, 0x3d\n\t"
+        ".long 0x53053053\n\t"                      // RSEQ_SIGNATURE
+        "4:\n\t"
+        "jmp %l[abort]\n\t"
+        ".popsection\n\t"
+        :
+        : [cpu] "r" (cpu),
+          [current_cpu] "m" (rs->cpu_id),
+          [rseq_cs] "m" (rs->rseq_cs),
+          [slot] "m" (*slot)
+        : "memory", "cc", "rax"
+        : abort);
+    return true;
+abort:
+    return false;
+}
+#endif
+
+/// rseq 尝试次数，连续被打断超过该次数时本次递增走回退路径
+constexpr int RSEQ_MAX_ATTEMPTS = 8;
+
+} // namespace percpu_detail
+
+template <>
+class ThreadSafeCounter<PerCpuPolicy> {
+private:
+    /// 每个 CPU 一个缓存行：rseq 路径只写 local，回退路径只对 shared 做原子加，
+    /// 两者不混用同一个字，避免普通 addq 与 lock add 交错丢失更新
+    struct alignas(CACHE_LINE_SIZE) Slot {
+        long local;
+        std::atomic<long> shared;
+        Slot() : local(0), shared(0) {}
+    };
+
+    Slot* slots;
+    int num_slots;
+
+    Slot& slot_for(int cpu) { return slots[(cpu >= 0 && cpu < num_slots) ? cpu : 0]; }
+
+    void increment_fallback() {
+        slot_for(sched_getcpu()).shared.fetch_add(1, std::memory_order_relaxed);
+    }
+
+public:
+    ThreadSafeCounter() : slots(nullptr), num_slots(get_nprocs_conf()) {
+        if (num_slots < 1) {
+            num_slots = 1;
+        }
+        slots = new Slot[num_slots];
+    }
+
+    ~ThreadSafeCounter() { delete[] slots; }
+
+    ThreadSafeCounter(const ThreadSafeCounter&) = delete;
+    ThreadSafeCounter& operator=(const ThreadSafeCounter&) = delete;
+
+    static const char* name() { return PerCpuPolicy::name(); }
+
+    /**
+     * @brief 当前线程能否走 rseq 快路径
+     */
+    static bool rseq_available() {
+#ifdef COUNTER_HAVE_RSEQ
+        return percpu_detail::thread_rseq() != nullptr;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief 递增当前 CPU 的槽位
+     *
+     * 不返回值：槽位的值既不是全局计数，也可能已包含同一 CPU 上其他线程
+     * 随后的递增，不能当作序号使用；需要计数时调用 get()。
+     */
+    void increment() {
+#ifdef COUNTER_HAVE_RSEQ
+        struct rseq* rs = percpu_detail::thread_rseq();
+        if (rs != nullptr) {
+            for (int attempt = 0; attempt < percpu_detail::RSEQ_MAX_ATTEMPTS; ++attempt) {
+                int cpu = static_cast<int>(__atomic_load_n(&rs->cpu_id_start, __ATOMIC_RELAXED));
+                if (cpu >= num_slots) {
+                    break;
+                }
+                Slot& slot = slots[cpu];
+                if (percpu_detail::rseq_add_one(rs, &slot.local, cpu)) {
+                    return;
+                }
+            }
+        }
+#endif
+        increment_fallback();
+    }
+
+    /**
+     * @brief 所有 CPU 槽位之和；并发递增时不是线性化快照，静止后精确
+     */
+    int get() const {
+        long sum = 0;
+        for (int i = 0; i < num_slots; ++i) {
+            sum += __atomic_load_n(&slots[i].local, __ATOMIC_RELAXED);
+            sum += slots[i].shared.load(std::memory_order_relaxed);
+        }
+        return static_cast<int>(sum);
+    }
+};
+
+inline const char* PerCpuPolicy::name() {
+    return ThreadSafeCounter<PerCpuPolicy>::rseq_available() ? "percpu-rseq" : "percpu-fallback";
+}
+
+#endif // PERCPUCOUNTER_H
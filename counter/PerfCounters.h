@@ -0,0 +1,302 @@
+#ifndef PERFCOUNTERS_H
+#define PERFCOUNTERS_H
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/**
+ * @brief 每个测试线程各自的硬件性能计数器（perf_event_open）
+ *
+ * 事件只统计打开它的线程，由线程自己在测量区间前后启停，结束后按线程相加，
+ * 再除以操作数得到每次操作的周期、指令、缓存缺失等。
+ *
+ * 容器和虚拟机里常常没有 PMU，或 perf_event_paranoid 不允许：打不开的事件
+ * 记为不可用（-1），全部打不开时整个功能静默关闭，测试照常运行。
+ * 内核态计数不被允许时退回只统计用户态。
+ *
+ * 同一路径还以 syscalls:sys_enter_futex 跟踪点统计 futex 系统调用，glibc
+ * 互斥锁内部的调用也在其中；tracefs 不可见或没有权限时该项同样记为不可用。
+ */
+
+/// 统计的事件；HITM 没有通用编码，只在已知的 CPU 上以原始事件打开；PERF_FUTEX_CALLS 是跟踪点而非硬件事件
+enum PerfEventKind {
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_CACHE_MISSES,
+    PERF_LLC_MISSES,
+    PERF_HITM,
+    PERF_FUTEX_CALLS,
+    PERF_EVENT_KINDS
+};
+
+inline const char* perf_event_name(int kind) {
+    static const char* const names[PERF_EVENT_KINDS] = {"cycles", "instructions", "cache_misses", "llc_misses", "hitm",
+                                                        "futex_calls"};
+    return names[kind];
+}
+
+/**
+ * @brief 一个或多个线程的计数值；-1 表示该事件不可用
+ *
+ * 事件被多路复用时已按 启用时间/实际计数时间 折算。
+ */
+struct PerfSample {
+    int threads = 0;                        ///< 合并了多少个线程，0 表示没有数据
+    double counts[PERF_EVENT_KINDS] = {-1, -1, -1, -1, -1, -1};
+
+    bool available(int kind) const { return threads > 0 && counts[kind] >= 0; }
+
+    bool any_available() const {
+        for (int kind = 0; kind < PERF_EVENT_KINDS; ++kind) {
+            if (available(kind)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// 每次操作的平均计数；不可用或没有操作时为 -1
+    double per_operation(int kind, std::size_t operations) const {
+        return available(kind) && operations > 0 ? counts[kind] / operations : -1.0;
+    }
+
+    /// 累加另一个线程的计数；任一方不可用的事件合并后仍不可用
+    void merge(const PerfSample& other) {
+        if (other.threads == 0) {
+            return;
+        }
+        for (int kind = 0; kind < PERF_EVENT_KINDS; ++kind) {
+            counts[kind] = threads == 0 ? other.counts[kind]
+                         : counts[kind] < 0 || other.counts[kind] < 0 ? -1.0 : counts[kind] + other.counts[kind];
+        }
+        threads += other.threads;
+    }
+};
+
+/**
+ * @brief /proc/cpuinfo 中第一个 key 字段的值，没有时为空串
+ */
+inline std::string cpuinfo_field(const std::string& key) {
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+        const std::size_t colon = line.find(':');
+        if (colon != std::string::npos && line.compare(0, key.size(), key) == 0 &&
+            line.find_first_not_of(" \t", key.size()) == colon) {
+            const std::size_t begin = line.find_first_not_of(" \t", colon + 1);
+            return begin == std::string::npos ? "" : line.substr(begin);
+        }
+    }
+    return "";
+}
+
+class PerfCounters {
+private:
+    int fds[PERF_EVENT_KINDS];
+    bool attempted = false;
+
+    /// 运行期开关与探测结果，所有线程共用
+    struct Settings {
+        std::atomic<bool> enabled{true};
+        std::atomic<bool> user_only{false}; ///< 内核态计数被拒绝后只统计用户态
+    };
+
+    static Settings& settings() {
+        static Settings instance;
+        return instance;
+    }
+
+    /**
+     * @brief HITM（读到其他核修改过的缓存行）的原始事件编码，未知 CPU 返回 0
+     *
+     * Intel 自 Nehalem 起的大核上为 event 0xD2 umask 0x04
+     * （MEM_LOAD_[UOPS_LLC_]L3_HIT_RETIRED.XSNP_HITM，新手册中改名 XSNP_FWD）。
+     */
+    static std::uint64_t hitm_raw_config() {
+        static const std::uint64_t config = []() -> std::uint64_t {
+            return cpuinfo_field("vendor_id") == "GenuineIntel" && cpuinfo_field("cpu family") == "6" ? 0x04d2 : 0;
+        }();
+        return config;
+    }
+
+    /**
+     * @brief syscalls:sys_enter_futex 跟踪点的编号，tracefs 不可见时返回 0
+     */
+    static std::uint64_t futex_tracepoint_id() {
+        static const std::uint64_t id = []() -> std::uint64_t {
+            for (const char* path : {"/sys/kernel/tracing/events/syscalls/sys_enter_futex/id",
+                                     "/sys/kernel/debug/tracing/events/syscalls/sys_enter_futex/id"}) {
+                std::ifstream file(path);
+                std::uint64_t value = 0;
+                if (file >> value) {
+                    return value;
+                }
+            }
+            return 0;
+        }();
+        return id;
+    }
+
+    static bool describe(int kind, perf_event_attr& attr) {
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        switch (kind) {
+        case PERF_CYCLES:       attr.config = PERF_COUNT_HW_CPU_CYCLES; break;
+        case PERF_INSTRUCTIONS: attr.config = PERF_COUNT_HW_INSTRUCTIONS; break;
+        case PERF_CACHE_MISSES: attr.config = PERF_COUNT_HW_CACHE_MISSES; break;
+        case PERF_LLC_MISSES:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                          (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            break;
+        case PERF_FUTEX_CALLS:
+            if (futex_tracepoint_id() == 0) {
+                return false;
+            }
+            attr.type = PERF_TYPE_TRACEPOINT;
+            attr.config = futex_tracepoint_id();
+            break;
+        default:
+            if (hitm_raw_config() == 0) {
+                return false;
+            }
+            attr.type = PERF_TYPE_RAW;
+            attr.config = hitm_raw_config();
+            break;
+        }
+        attr.disabled = 1;
+        attr.exclude_hv = 1;
+        attr.exclude_kernel = settings().user_only.load(std::memory_order_relaxed) ? 1 : 0;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        return true;
+    }
+
+    /// 为当前线程打开一个事件；硬件事件的内核态计数被拒绝时改为只统计用户态再试一次
+    static int open_event(int kind, int& error) {
+        perf_event_attr attr;
+        if (!describe(kind, attr)) {
+            error = ENOENT;
+            return -1;
+        }
+        int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+        // 跟踪点本来就在内核里触发，被拒绝时不必改为只统计用户态，也不能因此影响硬件事件
+        if (fd < 0 && (errno == EACCES || errno == EPERM) && !attr.exclude_kernel && kind != PERF_FUTEX_CALLS) {
+            settings().user_only.store(true, std::memory_order_relaxed);
+            attr.exclude_kernel = 1;
+            fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+        }
+        error = fd < 0 ? errno : 0;
+        return fd;
+    }
+
+public:
+    PerfCounters() {
+        for (int& fd : fds) {
+            fd = -1;
+        }
+    }
+
+    ~PerfCounters() {
+        for (int fd : fds) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    /// 是否在测试线程中打开计数器（默认开启，probe() 发现不可用时自动关闭）
+    static bool enabled() { return settings().enabled.load(std::memory_order_relaxed); }
+    static void set_enabled(bool on) { settings().enabled.store(on, std::memory_order_relaxed); }
+
+    /// 是否只统计用户态
+    static bool user_only() { return settings().user_only.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 在当前线程上试开每个事件，记录哪些可用；全部不可用时关闭整个功能
+     * @param errors 各事件打开失败时的 errno，成功为 0
+     * @return 可用事件数
+     */
+    static int probe(int (&errors)[PERF_EVENT_KINDS]) {
+        int available = 0;
+        for (int kind = 0; kind < PERF_EVENT_KINDS; ++kind) {
+            const int fd = open_event(kind, errors[kind]);
+            if (fd >= 0) {
+                ++available;
+                close(fd);
+            }
+        }
+        if (available == 0) {
+            set_enabled(false);
+        }
+        return available;
+    }
+
+    /**
+     * @brief 为调用线程打开计数器（处于停止状态），每个对象只尝试一次
+     *
+     * 必须在要统计的线程上调用；打不开的事件记为不可用。
+     */
+    void open() {
+        if (attempted) {
+            return;
+        }
+        attempted = true;
+        for (int kind = 0; kind < PERF_EVENT_KINDS; ++kind) {
+            int error = 0;
+            fds[kind] = open_event(kind, error);
+        }
+    }
+
+    /// 清零并开始计数；没有打开的事件时什么也不做
+    void start() {
+        for (int fd : fds) {
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+    }
+
+    void stop() {
+        for (int fd : fds) {
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            }
+        }
+    }
+
+    /**
+     * @brief 最近一次 start() 到 stop() 的计数，可在其他线程读取；没有打开任何事件时 threads 为 0
+     */
+    PerfSample read() const {
+        PerfSample sample;
+        for (int kind = 0; kind < PERF_EVENT_KINDS; ++kind) {
+            std::uint64_t values[3];
+            if (fds[kind] < 0 || ::read(fds[kind], values, sizeof(values)) != static_cast<ssize_t>(sizeof(values))) {
+                continue;
+            }
+            sample.threads = 1;
+            // values: 计数、启用时间、实际计数时间；从未被调度到 PMU 上时无法折算
+            if (values[2] > 0) {
+                sample.counts[kind] = static_cast<double>(values[0]) * values[1] / values[2];
+            } else if (values[1] == 0) {
+                sample.counts[kind] = 0.0;
+            }
+        }
+        return sample;
+    }
+};
+
+#endif // PERFCOUNTERS_H
@@ -0,0 +1,72 @@
+#ifndef PHASEFAIRRWLOCK_H
+#define PHASEFAIRRWLOCK_H
+
+#include <atomic>
+#include "Platform.h"
+
+/**
+ * @brief 阶段公平 (phase-fair) 的读写票据自旋锁策略 (Brandenburg & Anderson, PF-T)
+ *
+ * 读者与写者按"阶段"交替：写者到达后，新来的读者要等这个写者完成；
+ * 写者完成后，在它之前排队的读者全部一起进入，之后才轮到下一个写者。
+ * 因此读者最多等待一个写阶段，写者也不会被源源不断的读者饿死。
+ *
+ * 读者计数 rin/rout 的高位按 READER_INC 递增，低两位记录写者状态：
+ * WRITER_PRESENT 表示有写者在场，PHASE_ID 区分相邻两个写者，
+ * 使读者能分辨自己等待的写者是否已经换人。写者之间用 win/wout 票据排队。
+ *
+ * 提供 lock()/unlock()（写）与 lock_shared()/unlock_shared()（读），
+ * ThreadSafeCounter 检测到 lock_shared() 时让 get() 走读锁。
+ */
+class PhaseFairRwLockPolicy {
+private:
+    static constexpr unsigned READER_INC = 0x100;
+    static constexpr unsigned WRITER_BITS = 0x3;
+    static constexpr unsigned WRITER_PRESENT = 0x2;
+    static constexpr unsigned PHASE_ID = 0x1;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<unsigned> rin;
+    std::atomic<unsigned> rout;
+    alignas(CACHE_LINE_SIZE) std::atomic<unsigned> win;
+    std::atomic<unsigned> wout;
+
+public:
+    static const char* name() { return "pf-rwlock"; }
+
+    PhaseFairRwLockPolicy() : rin(0), rout(0), win(0), wout(0) {}
+
+    PhaseFairRwLockPolicy(const PhaseFairRwLockPolicy&) = delete;
+    PhaseFairRwLockPolicy& operator=(const PhaseFairRwLockPolicy&) = delete;
+
+    void lock_shared() {
+        const unsigned writer = rin.fetch_add(READER_INC, std::memory_order_acquire) & WRITER_BITS;
+        // 到达时有写者在场：等到写者位变化（该写者离开，或下一阶段的写者已换人）
+        unsigned spun = 0;
+        while (writer != 0 && writer == (rin.load(std::memory_order_acquire) & WRITER_BITS)) {
+            spin_pause(spun);
+        }
+    }
+
+    void unlock_shared() { rout.fetch_add(READER_INC, std::memory_order_release); }
+
+    void lock() {
+        const unsigned ticket = win.fetch_add(1, std::memory_order_relaxed);
+        unsigned spun = 0;
+        while (wout.load(std::memory_order_acquire) != ticket) {
+            spin_pause(spun);
+        }
+        // 宣告写者在场，阻止后来的读者；记下此前已进入的读者数，等它们全部离开
+        const unsigned readers_entered = rin.fetch_add(WRITER_PRESENT | (ticket & PHASE_ID), std::memory_order_acquire);
+        spun = 0;
+        while (rout.load(std::memory_order_acquire) != readers_entered) {
+            spin_pause(spun);
+        }
+    }
+
+    void unlock() {
+        rin.fetch_and(~WRITER_BITS, std::memory_order_release);
+        wout.store(wout.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+};
+
+#endif // PHASEFAIRRWLOCK_H
@@ -0,0 +1,79 @@
+#ifndef PLATFORM_H
+#define PLATFORM_H
+
+#include <cstddef>
+#include <atomic>
+#include <thread>
+#include <sched.h>
+
+/**
+ * @brief 平台相关的常量与小工具，供各个后端共用
+ */
+
+/// 缓存行大小（x86-64 / 大多数 ARM64 为 64 字节），用于填充避免伪共享
+constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+#ifdef COUNTER_LOCK_PROFILING
+/**
+ * @brief 当前线程累计的自旋轮数；锁剖析在加锁前后各读一次，差值即本次加锁的自旋轮数
+ */
+inline unsigned long& profiled_spin_count() {
+    thread_local unsigned long count = 0;
+    return count;
+}
+#endif
+
+/**
+ * @brief 记录一轮自旋，仅在定义 COUNTER_LOCK_PROFILING 时生效
+ */
+inline void note_spin() {
+#ifdef COUNTER_LOCK_PROFILING
+    ++profiled_spin_count();
+#endif
+}
+
+/**
+ * @brief 自旋等待时的 CPU 提示（x86 的 pause / ARM 的 yield）
+ *
+ * 降低自旋循环的功耗和对同一物理核上超线程兄弟的干扰，
+ * 并避免退出自旋时的内存顺序冲突流水线清空。
+ */
+inline void cpu_relax() {
+    note_spin();
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield" ::: "memory");
+#else
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+/**
+ * @brief 在线 CPU 数（至少为 1），首次调用后缓存
+ */
+inline unsigned online_cpus() {
+    static const unsigned cpus = std::thread::hardware_concurrency() > 0 ? std::thread::hardware_concurrency() : 1;
+    return cpus;
+}
+
+/// 单次等待中累计自旋超过该轮数后改为让出 CPU
+constexpr unsigned SPIN_YIELD_THRESHOLD = 1u << 10;
+
+/**
+ * @brief 自旋等待的一轮：通常 pause，单 CPU 或自旋过久时 sched_yield
+ *
+ * 单 CPU 上等待者自旋时持有者不可能在运行；超订时等待的对象也可能已被
+ * 调度出去，这两种情况下让出 CPU 才能让持有者尽快前进。
+ * @param spun 本次等待已自旋的轮数，由调用者在等待开始时清零
+ */
+inline void spin_pause(unsigned& spun) {
+    if (online_cpus() == 1 || ++spun > SPIN_YIELD_THRESHOLD) {
+        note_spin();
+        sched_yield();
+    } else {
+        cpu_relax();
+    }
+}
+
+#endif // PLATFORM_H
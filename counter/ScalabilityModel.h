@@ -0,0 +1,147 @@
+#ifndef SCALABILITYMODEL_H
+#define SCALABILITYMODEL_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+/**
+ * @brief 扩展性曲线上的一个点：N 个线程、每线程固定工作量时测得的吞吐量
+ */
+struct ScalingPoint {
+    int threads;
+    double throughput;
+};
+
+/**
+ * @brief Amdahl 定律与通用扩展性定律（USL）的拟合结果
+ *
+ * USL：X(N) = λN / (1 + σ(N-1) + κN(N-1))
+ * - λ：单线程吞吐量
+ * - σ：竞争系数，串行部分的比例（排队等锁），使吞吐量趋于上限 λ/σ
+ * - κ：一致性系数，线程两两之间同步的代价（缓存行来回传递），使吞吐量越过峰值后下降
+ * Amdahl 即 κ = 0 的特例。
+ */
+struct ScalingFit {
+    bool valid = false;
+    int points = 0;                 ///< 参与拟合的点数
+    double lambda = 0.0;
+    double sigma = 0.0;
+    double kappa = 0.0;
+    double usl_r2 = 0.0;            ///< USL 对吞吐量的决定系数
+    double amdahl_sigma = 0.0;
+    double amdahl_r2 = 0.0;
+    bool usl_bounded = false;       ///< σ 的最小二乘解落在 [0,1] 之外被截断，数据不符合 USL
+    bool amdahl_bounded = false;    ///< Amdahl 的 σ 被截断到 [0,1]
+
+    double usl_throughput(double threads) const {
+        return lambda * threads / (1.0 + sigma * (threads - 1.0) + kappa * threads * (threads - 1.0));
+    }
+
+    double amdahl_throughput(double threads) const {
+        return lambda * threads / (1.0 + amdahl_sigma * (threads - 1.0));
+    }
+
+    /**
+     * @brief USL 吞吐量峰值所在的线程数 sqrt((1-σ)/κ)
+     *
+     * σ 为 1 时吞吐量从单线程起就不再增加，返回 1；κ 为 0 时不存在峰值，返回无穷大。
+     */
+    double peak_threads() const {
+        if (sigma >= 1.0) {
+            return 1.0;
+        }
+        return kappa > 0.0 ? std::sqrt((1.0 - sigma) / kappa) : std::numeric_limits<double>::infinity();
+    }
+};
+
+/**
+ * @brief 拟合 Amdahl 与 USL 参数
+ *
+ * λ 取单线程点的吞吐量（多次测量取平均），其余各点化成 Gunther 的线性形式：
+ * 令 x = N-1，y = N·λ/X(N) - 1，则 y = σx + κx(x+1)，对过原点的二次式做最小二乘；
+ * κ 为负时视为 0 只拟合 σ；σ 限制在 [0,1]，落到边界时固定 σ 重新拟合 κ，
+ * 并置 usl_bounded。Amdahl 只保留 σx 一项，同样限制在 [0,1]。
+ * @return 没有单线程点或少于两个不同线程数时 valid 为 false
+ */
+inline ScalingFit fit_scaling(const std::vector<ScalingPoint>& points) {
+    ScalingFit fit;
+    double single = 0.0;
+    int singles = 0;
+    for (const ScalingPoint& point : points) {
+        if (point.threads == 1) {
+            single += point.throughput;
+            ++singles;
+        }
+    }
+    if (singles == 0 || single <= 0.0) {
+        return fit;
+    }
+    fit.lambda = single / singles;
+
+    // 正规方程的各项：u = x，v = x(x+1)
+    double uu = 0.0, uv = 0.0, vv = 0.0, uy = 0.0, vy = 0.0;
+    int multi = 0;
+    for (const ScalingPoint& point : points) {
+        if (point.threads <= 1 || point.throughput <= 0.0) {
+            continue;
+        }
+        const double x = point.threads - 1.0;
+        const double u = x;
+        const double v = x * (x + 1.0);
+        const double y = point.threads * fit.lambda / point.throughput - 1.0;
+        uu += u * u;
+        uv += u * v;
+        vv += v * v;
+        uy += u * y;
+        vy += v * y;
+        ++multi;
+    }
+    if (multi == 0) {
+        return fit;
+    }
+
+    const double amdahl_sigma = uy / uu;
+    fit.amdahl_sigma = std::min(1.0, std::max(0.0, amdahl_sigma));
+    fit.amdahl_bounded = fit.amdahl_sigma != amdahl_sigma;
+
+    const double det = uu * vv - uv * uv;
+    if (det > 1e-12 * uu * vv) {
+        fit.sigma = (uy * vv - vy * uv) / det;
+        fit.kappa = (vy * uu - uy * uv) / det;
+    } else {
+        fit.sigma = uy / uu;
+        fit.kappa = 0.0;
+    }
+    if (fit.kappa < 0.0) {
+        fit.kappa = 0.0;
+        fit.sigma = uy / uu;
+    }
+    // σ 固定在边界上时，κ 是 y - σu ≈ κv 的最小二乘解
+    if (fit.sigma < 0.0 || fit.sigma > 1.0) {
+        fit.sigma = fit.sigma < 0.0 ? 0.0 : 1.0;
+        fit.kappa = std::max(0.0, (vy - fit.sigma * uv) / vv);
+        fit.usl_bounded = true;
+    }
+
+    // 决定系数按原始吞吐量计算，包括单线程点
+    double mean = 0.0;
+    for (const ScalingPoint& point : points) {
+        mean += point.throughput;
+    }
+    mean /= points.size();
+    double total = 0.0, usl_residual = 0.0, amdahl_residual = 0.0;
+    for (const ScalingPoint& point : points) {
+        total += (point.throughput - mean) * (point.throughput - mean);
+        usl_residual += std::pow(point.throughput - fit.usl_throughput(point.threads), 2);
+        amdahl_residual += std::pow(point.throughput - fit.amdahl_throughput(point.threads), 2);
+    }
+    fit.usl_r2 = total > 0.0 ? 1.0 - usl_residual / total : 1.0;
+    fit.amdahl_r2 = total > 0.0 ? 1.0 - amdahl_residual / total : 1.0;
+    fit.points = static_cast<int>(points.size());
+    fit.valid = true;
+    return fit;
+}
+
+#endif // SCALABILITYMODEL_H
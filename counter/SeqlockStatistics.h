@@ -0,0 +1,119 @@
+#ifndef SEQLOCKSTATISTICS_H
+#define SEQLOCKSTATISTICS_H
+
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include "Platform.h"
+#include "LockPolicies.h"
+
+/**
+ * @brief SeqlockStatistics 的一致性快照
+ */
+struct StatisticsSnapshot {
+    long long count;              ///< 记录次数
+    long long sum;                ///< 所有记录值之和
+    long long min;                ///< 最小值；count 为 0 时为 LLONG_MAX
+    long long max;                ///< 最大值；count 为 0 时为 LLONG_MIN
+    long long last_updated_ns;    ///< 最后一次记录的 steady_clock 时间戳（纳秒），未记录时为 0
+};
+
+/**
+ * @brief 由顺序锁 (seqlock) 保护的多字段统计对象
+ *
+ * 写者之间用 WriterLock 互斥，写入前后各把序号加一（写入期间为奇数）；
+ * 读者不加锁、不写任何共享内存：读序号 → 读各字段 → 再读序号，
+ * 两次序号相同且为偶数时快照一致，否则重试。读多写少时读者之间
+ * 完全没有缓存行争用。字段用 relaxed 原子变量存放，避免读写并发时的数据竞争。
+ *
+ * @tparam WriterLock 写者互斥用的锁策略，默认 pthread 自旋锁
+ */
+template <typename WriterLock = SpinLockPolicy>
+class SeqlockStatistics {
+private:
+    alignas(CACHE_LINE_SIZE) std::atomic<unsigned long> sequence;
+    std::atomic<long long> count;
+    std::atomic<long long> sum;
+    std::atomic<long long> min;
+    std::atomic<long long> max;
+    std::atomic<long long> last_updated_ns;
+    WriterLock writer_lock;
+
+    static long long now_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+public:
+    static const char* name() { return "seqlock-stats"; }
+
+    SeqlockStatistics()
+        : sequence(0), count(0), sum(0),
+          min(std::numeric_limits<long long>::max()),
+          max(std::numeric_limits<long long>::min()),
+          last_updated_ns(0) {}
+
+    SeqlockStatistics(const SeqlockStatistics&) = delete;
+    SeqlockStatistics& operator=(const SeqlockStatistics&) = delete;
+
+    /**
+     * @brief 记录一个值，同时更新 count/sum/min/max/时间戳
+     */
+    void record(long long value) {
+        const long long timestamp = now_ns();
+        writer_lock.lock();
+        const unsigned long seq = sequence.load(std::memory_order_relaxed);
+        sequence.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        sum.store(sum.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        if (value < min.load(std::memory_order_relaxed)) {
+            min.store(value, std::memory_order_relaxed);
+        }
+        if (value > max.load(std::memory_order_relaxed)) {
+            max.store(value, std::memory_order_relaxed);
+        }
+        // 时间戳在锁外取得，多个写者交错时只保留较新的，保证单调
+        if (timestamp > last_updated_ns.load(std::memory_order_relaxed)) {
+            last_updated_ns.store(timestamp, std::memory_order_relaxed);
+        }
+
+        sequence.store(seq + 2, std::memory_order_release);
+        writer_lock.unlock();
+    }
+
+    /**
+     * @brief 无锁读取一致性快照
+     * @param retries 若非空，累加本次因写者并发而重试的次数
+     */
+    StatisticsSnapshot snapshot(unsigned long* retries = nullptr) const {
+        StatisticsSnapshot result;
+        unsigned spun = 0;
+        for (;;) {
+            const unsigned long begin = sequence.load(std::memory_order_acquire);
+            if (begin & 1) {
+                // 写者正在写，等它结束
+                if (retries != nullptr) {
+                    ++*retries;
+                }
+                spin_pause(spun);
+                continue;
+            }
+            result.count = count.load(std::memory_order_relaxed);
+            result.sum = sum.load(std::memory_order_relaxed);
+            result.min = min.load(std::memory_order_relaxed);
+            result.max = max.load(std::memory_order_relaxed);
+            result.last_updated_ns = last_updated_ns.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence.load(std::memory_order_relaxed) == begin) {
+                return result;
+            }
+            if (retries != nullptr) {
+                ++*retries;
+            }
+        }
+    }
+};
+
+#endif // SEQLOCKSTATISTICS_H
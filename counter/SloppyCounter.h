@@ -0,0 +1,144 @@
+#ifndef SLOPPYCOUNTER_H
+#define SLOPPYCOUNTER_H
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include "Platform.h"
+#include "ThreadIndex.h"
+#include "ThreadSafeCounter.h"
+
+/**
+ * @brief 线程局部缓冲的"粗略" (sloppy) 计数器后端标签
+ *
+ * increment() 只改当前线程自己的局部增量，增量达到阈值 Threshold 时
+ * 才一次性加到全局值上；线程退出时也会把剩余增量刷入全局值。
+ * 每个线程未刷入的增量严格小于 Threshold，因此 get() 读到的全局值
+ * 最多落后真实值 活跃线程数 × Threshold。需要精确值时调用 get_exact()。
+ *
+ * @tparam Threshold 刷新阈值 S；为 1 时每次递增都刷新，等价于原子计数器
+ */
+template <unsigned Threshold>
+struct SloppyPolicy {
+    static_assert(Threshold >= 1, "刷新阈值至少为 1");
+
+    static const char* name() {
+        static const std::string text = "sloppy-" + std::to_string(Threshold);
+        return text.c_str();
+    }
+};
+
+namespace sloppy_detail {
+
+/**
+ * @brief 计数器的共享部分：全局值与按线程编号索引的局部增量槽
+ *
+ * 由计数器持有，并登记到各递增线程的退出回调表；
+ * 线程退出时把本线程的剩余增量刷入全局值。
+ */
+struct Core : ThreadExitListener {
+    /// 每个槽只由编号对应的线程写，其它线程只在 get_exact() 时读
+    struct alignas(CACHE_LINE_SIZE) Slot {
+        std::atomic<long> delta{0};
+        bool registered = false;            ///< 当前持有该编号的线程是否已登记退出刷新
+    };
+
+    /// 局部增量槽数量；编号超过该值的线程直接加到全局值上
+    static constexpr unsigned MAX_THREADS = 1024;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<long> global{0};
+    std::atomic<unsigned> used_slots{0};    ///< 曾经使用过的最大槽号 + 1，限制求和范围
+    std::unique_ptr<Slot[]> slots{new Slot[MAX_THREADS]};
+
+    /// 把槽 index 中的增量刷入全局值；只能由持有该编号的线程调用
+    void flush(unsigned index) {
+        Slot& slot = slots[index];
+        const long pending = slot.delta.load(std::memory_order_relaxed);
+        if (pending != 0) {
+            global.fetch_add(pending, std::memory_order_relaxed);
+            slot.delta.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void on_thread_exit(unsigned index) override {
+        flush(index);
+        slots[index].registered = false;
+    }
+};
+
+} // namespace sloppy_detail
+
+template <unsigned Threshold>
+class ThreadSafeCounter<SloppyPolicy<Threshold>> {
+private:
+    std::shared_ptr<sloppy_detail::Core> owner;
+    sloppy_detail::Core* core;              ///< owner.get()，热路径上省去一次间接
+
+    /// 当前线程第一次递增本计数器：扩展求和范围并登记退出刷新
+    void register_thread(unsigned index) {
+        unsigned used = core->used_slots.load(std::memory_order_relaxed);
+        while (used <= index && !core->used_slots.compare_exchange_weak(used, index + 1, std::memory_order_release)) {
+        }
+        ThreadExitHooks::local().add(owner);
+        core->slots[index].registered = true;
+    }
+
+public:
+    ThreadSafeCounter() : owner(std::make_shared<sloppy_detail::Core>()), core(owner.get()) {}
+
+    ThreadSafeCounter(const ThreadSafeCounter&) = delete;
+    ThreadSafeCounter& operator=(const ThreadSafeCounter&) = delete;
+
+    static const char* name() { return SloppyPolicy<Threshold>::name(); }
+
+    /// get() 相对真实值的最大落后量
+    static long error_bound(int threads) { return static_cast<long>(threads) * Threshold; }
+
+    /**
+     * @brief 递增当前线程的局部增量，达到阈值时刷入全局值
+     * @return 全局值加上本线程未刷入的增量，是近似值，误差界与 get() 相同
+     */
+    int increment() {
+        const unsigned index = thread_index();
+        if (index >= sloppy_detail::Core::MAX_THREADS) {
+            return static_cast<int>(core->global.fetch_add(1, std::memory_order_relaxed) + 1);
+        }
+        sloppy_detail::Core::Slot& slot = core->slots[index];
+        if (!slot.registered) {
+            register_thread(index);
+        }
+        // 只有本线程写这个槽，读-改-写不需要原子指令
+        const long pending = slot.delta.load(std::memory_order_relaxed) + 1;
+        if (pending >= static_cast<long>(Threshold)) {
+            slot.delta.store(0, std::memory_order_relaxed);
+            return static_cast<int>(core->global.fetch_add(pending, std::memory_order_relaxed) + pending);
+        }
+        slot.delta.store(pending, std::memory_order_relaxed);
+        return static_cast<int>(core->global.load(std::memory_order_relaxed) + pending);
+    }
+
+    /**
+     * @brief 近似值：只读全局值，不接触任何线程的局部槽
+     *
+     * 结果不大于真实值，且最多落后 error_bound(递增过本计数器的存活线程数)；
+     * 所有递增线程退出后精确。
+     */
+    int get() const { return static_cast<int>(core->global.load(std::memory_order_relaxed)); }
+
+    /**
+     * @brief 精确值：全局值加上所有线程未刷入的增量
+     *
+     * 扫描所有槽，代价与线程数成正比。与递增并发时各槽读取不在同一时刻，
+     * 结果只保证在调用期间真实值的变化范围附近；没有并发递增时精确。
+     */
+    int get_exact() const {
+        long sum = core->global.load(std::memory_order_relaxed);
+        const unsigned limit = core->used_slots.load(std::memory_order_acquire);
+        for (unsigned i = 0; i < limit; ++i) {
+            sum += core->slots[i].delta.load(std::memory_order_relaxed);
+        }
+        return static_cast<int>(sum);
+    }
+};
+
+#endif // SLOPPYCOUNTER_H
@@ -0,0 +1,225 @@
+#ifndef STRIPEDCOUNTER_H
+#define STRIPEDCOUNTER_H
+
+#include <atomic>
+#include <thread>
+#include <functional>
+#include "Platform.h"
+#include "ThreadSafeCounter.h"
+
+/**
+ * @brief 竞争自适应的分段计数器后端标签（LongAdder 风格）
+ *
+ * 无竞争时只对 base 做 CAS；一旦 CAS 失败，计数器膨胀为按缓存行填充的
+ * 单元数组，各线程按探针哈希到不同单元上，冲突继续出现时数组倍增，
+ * 上限为不小于 CPU 数的 2 的幂。get() 返回 base 与所有单元之和。
+ */
+struct StripedPolicy {
+    static const char* name() { return "striped"; }
+};
+
+/**
+ * @brief 每个线程的哈希探针，所有分段计数器共用；0 表示尚未初始化
+ */
+inline unsigned& striped_probe() {
+    thread_local unsigned probe = 0;
+    return probe;
+}
+
+template <>
+class ThreadSafeCounter<StripedPolicy> {
+private:
+    /// 独占一个缓存行的计数单元
+    struct alignas(CACHE_LINE_SIZE) Cell {
+        std::atomic<int> value;
+        explicit Cell(int initial) : value(initial) {}
+    };
+
+    /// 单元指针表；扩容时复制指针到新表，旧表挂在 previous 上直到析构才释放
+    struct Table {
+        unsigned size;
+        std::atomic<Cell*>* cells;
+        Table* previous;
+
+        Table(unsigned n, Table* prev) : size(n), cells(new std::atomic<Cell*>[n]), previous(prev) {
+            for (unsigned i = 0; i < n; ++i) {
+                cells[i].store(nullptr, std::memory_order_relaxed);
+            }
+        }
+        ~Table() { delete[] cells; }
+    };
+
+    alignas(CACHE_LINE_SIZE) std::atomic<int> base;
+    std::atomic<Table*> table;
+    std::atomic<bool> busy;           ///< 创建单元/扩容时使用的自旋标志
+    unsigned max_cells;
+
+    static unsigned next_power_of_two(unsigned n) {
+        unsigned p = 1;
+        while (p < n) {
+            p <<= 1;
+        }
+        return p;
+    }
+
+    static unsigned init_probe() {
+        unsigned& probe = striped_probe();
+        if (probe == 0) {
+            probe = static_cast<unsigned>(std::hash<std::thread::id>()(std::this_thread::get_id())) | 1u;
+        }
+        return probe;
+    }
+
+    /// xorshift 换一个探针，冲突后换到其它单元
+    static unsigned advance_probe(unsigned probe) {
+        probe ^= probe << 13;
+        probe ^= probe >> 17;
+        probe ^= probe << 5;
+        striped_probe() = probe;
+        return probe;
+    }
+
+    bool try_lock_busy() {
+        return !busy.load(std::memory_order_relaxed) && !busy.exchange(true, std::memory_order_acquire);
+    }
+
+    void unlock_busy() { busy.store(false, std::memory_order_release); }
+
+    /**
+     * @brief 慢路径：base 或单元 CAS 失败后进入，负责创建单元、换探针和扩容
+     */
+    void increment_contended(unsigned probe, bool was_uncontended) {
+        bool collide = false;
+        for (;;) {
+            Table* t = table.load(std::memory_order_acquire);
+            if (t != nullptr) {
+                Cell* c = t->cells[probe & (t->size - 1)].load(std::memory_order_acquire);
+                if (c == nullptr) {
+                    if (try_lock_busy()) {
+                        // 持有 busy 时重新读取当前表，保证新单元总在最新的表里
+                        Table* current = table.load(std::memory_order_relaxed);
+                        std::atomic<Cell*>& slot = current->cells[probe & (current->size - 1)];
+                        if (slot.load(std::memory_order_relaxed) == nullptr) {
+                            slot.store(new Cell(1), std::memory_order_release);
+                            unlock_busy();
+                            return;
+                        }
+                        unlock_busy();
+                        continue;
+                    }
+                    collide = false;
+                } else if (!was_uncontended) {
+                    was_uncontended = true;     // 已知快路径 CAS 失败，先换探针再重试
+                } else {
+                    int v = c->value.load(std::memory_order_relaxed);
+                    if (c->value.compare_exchange_weak(v, v + 1, std::memory_order_relaxed)) {
+                        return;
+                    }
+                    if (t->size >= max_cells || table.load(std::memory_order_relaxed) != t) {
+                        collide = false;        // 已达上限或表已被别人替换
+                    } else if (!collide) {
+                        collide = true;
+                    } else if (try_lock_busy()) {
+                        if (table.load(std::memory_order_relaxed) == t) {
+                            Table* grown = new Table(t->size * 2, t);
+                            for (unsigned i = 0; i < t->size; ++i) {
+                                grown->cells[i].store(t->cells[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+                            }
+                            table.store(grown, std::memory_order_release);
+                        }
+                        unlock_busy();
+                        collide = false;
+                        continue;               // 用同一探针在扩容后的表上重试
+                    }
+                }
+                probe = advance_probe(probe);
+            } else if (try_lock_busy()) {
+                if (table.load(std::memory_order_relaxed) == nullptr) {
+                    Table* created = new Table(2, nullptr);
+                    created->cells[probe & 1].store(new Cell(1), std::memory_order_relaxed);
+                    table.store(created, std::memory_order_release);
+                    unlock_busy();
+                    return;
+                }
+                unlock_busy();
+            } else {
+                int b = base.load(std::memory_order_relaxed);
+                if (base.compare_exchange_weak(b, b + 1, std::memory_order_relaxed)) {
+                    return;
+                }
+            }
+        }
+    }
+
+public:
+    ThreadSafeCounter() : base(0), table(nullptr), busy(false) {
+        unsigned ncpu = std::thread::hardware_concurrency();
+        max_cells = next_power_of_two(ncpu > 2 ? ncpu : 2);
+    }
+
+    ~ThreadSafeCounter() {
+        Table* t = table.load(std::memory_order_relaxed);
+        if (t != nullptr) {
+            // 最新的表包含所有单元
+            for (unsigned i = 0; i < t->size; ++i) {
+                delete t->cells[i].load(std::memory_order_relaxed);
+            }
+        }
+        while (t != nullptr) {
+            Table* previous = t->previous;
+            delete t;
+            t = previous;
+        }
+    }
+
+    ThreadSafeCounter(const ThreadSafeCounter&) = delete;
+    ThreadSafeCounter& operator=(const ThreadSafeCounter&) = delete;
+
+    static const char* name() { return StripedPolicy::name(); }
+
+    /**
+     * @brief 递增计数器
+     *
+     * 不返回值：更新的只是 base 或某个单元，它的值既不是全局计数也不唯一，
+     * 不能当作序号使用；需要计数时调用 get()。
+     */
+    void increment() {
+        Table* t = table.load(std::memory_order_acquire);
+        if (t == nullptr) {
+            int b = base.load(std::memory_order_relaxed);
+            if (!base.compare_exchange_weak(b, b + 1, std::memory_order_relaxed)) {
+                increment_contended(init_probe(), true);
+            }
+            return;
+        }
+        unsigned probe = init_probe();
+        Cell* c = t->cells[probe & (t->size - 1)].load(std::memory_order_acquire);
+        if (c == nullptr) {
+            increment_contended(probe, true);
+            return;
+        }
+        int v = c->value.load(std::memory_order_relaxed);
+        if (!c->value.compare_exchange_weak(v, v + 1, std::memory_order_relaxed)) {
+            increment_contended(probe, false);
+        }
+    }
+
+    /**
+     * @brief 返回 base 与所有单元之和；并发递增时不是线性化快照，静止后精确
+     */
+    int get() const {
+        int sum = base.load(std::memory_order_relaxed);
+        Table* t = table.load(std::memory_order_acquire);
+        if (t != nullptr) {
+            for (unsigned i = 0; i < t->size; ++i) {
+                Cell* c = t->cells[i].load(std::memory_order_acquire);
+                if (c != nullptr) {
+                    sum += c->value.load(std::memory_order_relaxed);
+                }
+            }
+        }
+        return sum;
+    }
+};
+
+#endif // STRIPEDCOUNTER_H
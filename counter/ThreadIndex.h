@@ -0,0 +1,106 @@
+#ifndef THREADINDEX_H
+#define THREADINDEX_H
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief 为每个线程分配一个小整数编号，线程退出后编号回收复用
+ */
+class ThreadIndexRegistry {
+private:
+    std::mutex mutex;
+    std::vector<unsigned> free_indices;
+    unsigned next_index = 0;
+
+public:
+    static ThreadIndexRegistry& instance() {
+        static ThreadIndexRegistry registry;
+        return registry;
+    }
+
+    unsigned acquire() {
+        std::lock_guard<std::mutex> guard(mutex);
+        if (!free_indices.empty()) {
+            unsigned index = free_indices.back();
+            free_indices.pop_back();
+            return index;
+        }
+        return next_index++;
+    }
+
+    void release(unsigned index) {
+        std::lock_guard<std::mutex> guard(mutex);
+        free_indices.push_back(index);
+    }
+};
+
+/**
+ * @brief 线程局部的编号持有者，线程退出时归还编号
+ */
+struct ThreadIndex {
+    unsigned value;
+    ThreadIndex() : value(ThreadIndexRegistry::instance().acquire()) {}
+    ~ThreadIndex() { ThreadIndexRegistry::instance().release(value); }
+};
+
+/**
+ * @brief 当前线程的小整数编号，在同时存活的线程之间唯一，从 0 开始紧凑分配
+ */
+inline unsigned thread_index() {
+    thread_local ThreadIndex index;
+    return index.value;
+}
+
+/**
+ * @brief 需要在线程退出时处理本线程私有数据的对象（例如把线程局部的余量归还）
+ */
+class ThreadExitListener {
+public:
+    virtual ~ThreadExitListener() {}
+    /// 在退出线程上调用，index 为该线程的编号，此时编号尚未归还
+    virtual void on_thread_exit(unsigned index) = 0;
+};
+
+/**
+ * @brief 线程局部的退出回调表
+ *
+ * 以 weak_ptr 持有监听者，监听者先于线程销毁时退出回调自动跳过。
+ * 调用 add() 前必须先调用过 thread_index()：线程局部对象按构造的逆序析构，
+ * 这样回调执行时本线程的编号尚未归还，不会与复用该编号的新线程冲突。
+ */
+class ThreadExitHooks {
+private:
+    struct Entry {
+        std::weak_ptr<ThreadExitListener> listener;
+        unsigned index;
+    };
+    std::vector<Entry> entries;
+
+public:
+    ~ThreadExitHooks() {
+        for (Entry& entry : entries) {
+            if (std::shared_ptr<ThreadExitListener> listener = entry.listener.lock()) {
+                listener->on_thread_exit(entry.index);
+            }
+        }
+    }
+
+    void add(const std::shared_ptr<ThreadExitListener>& listener) {
+        // 顺带清掉已销毁的监听者，避免长寿命线程的表无限增长
+        entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                     [](const Entry& entry) { return entry.listener.expired(); }),
+                      entries.end());
+        entries.push_back(Entry{listener, thread_index()});
+    }
+
+    static ThreadExitHooks& local() {
+        thread_index();
+        thread_local ThreadExitHooks hooks;
+        return hooks;
+    }
+};
+
+#endif // THREADINDEX_H
@@ -0,0 +1,131 @@
+#ifndef THREADPLACEMENT_H
+#define THREADPLACEMENT_H
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <pthread.h>
+#include <sched.h>
+#include "Topology.h"
+
+/**
+ * @brief 测试线程的 CPU 放置策略
+ *
+ * 每个策略把可用 CPU 排成一个顺序，第 i 个测试线程绑定到其中第 i 个
+ * （线程多于 CPU 时回绕）：
+ * - none：不绑定，由调度器决定（默认）
+ * - compact：先填满同一物理核的超线程，再用同插槽的下一个物理核，线程共享 L1/L2
+ * - scatter：每个物理核一个线程并轮流分到各插槽，用完物理核才使用超线程
+ * - per-socket：先用完一个插槽的物理核和超线程再用下一个，线程共享 L3 但不共享 L1/L2
+ * - cpus:列表：按给定顺序绑定，例如 cpus:0,2,4-7
+ */
+class ThreadPlacement {
+private:
+    std::string description;
+    std::vector<int> order;                 ///< 为空表示不绑定
+    mutable std::atomic<bool> warned{false};
+
+    ThreadPlacement() : description("none") {}
+
+    /// 按 key(位置) 升序排列可用 CPU
+    template <typename Key>
+    static std::vector<int> sorted_cpus(Key key) {
+        std::vector<CpuLocation> locations = CpuTopology::instance().cpus();
+        std::stable_sort(locations.begin(), locations.end(), [&key](const CpuLocation& a, const CpuLocation& b) {
+            return key(a) < key(b);
+        });
+        std::vector<int> cpus;
+        for (const CpuLocation& location : locations) {
+            cpus.push_back(location.cpu);
+        }
+        return cpus;
+    }
+
+public:
+    static ThreadPlacement& instance() {
+        static ThreadPlacement placement;
+        return placement;
+    }
+
+    ThreadPlacement(const ThreadPlacement&) = delete;
+    ThreadPlacement& operator=(const ThreadPlacement&) = delete;
+
+    /**
+     * @brief 按 spec 选择策略，须在启动测试线程前调用
+     * @return spec 无法识别或列表中有不可用的 CPU 时打印原因并返回 false
+     */
+    bool configure(const std::string& spec) {
+        std::vector<int> cpus;
+        if (spec == "compact") {
+            cpus = sorted_cpus([](const CpuLocation& l) { return std::make_tuple(l.package, l.core, l.sibling); });
+        } else if (spec == "scatter") {
+            cpus = sorted_cpus([](const CpuLocation& l) { return std::make_tuple(l.sibling, l.core, l.package); });
+        } else if (spec == "per-socket") {
+            cpus = sorted_cpus([](const CpuLocation& l) { return std::make_tuple(l.package, l.sibling, l.core); });
+        } else if (spec.compare(0, 5, "cpus:") == 0) {
+            cpus = parse_cpu_list(spec.substr(5));
+            if (cpus.empty()) {
+                std::cerr << "CPU 列表为空: " << spec << std::endl;
+                return false;
+            }
+            for (int cpu : cpus) {
+                if (!CpuTopology::instance().contains(cpu)) {
+                    std::cerr << "CPU " << cpu << " 不在线或不在本进程的亲和性掩码内" << std::endl;
+                    return false;
+                }
+            }
+        } else if (spec != "none") {
+            std::cerr << "未知的线程放置策略: " << spec << std::endl;
+            return false;
+        }
+        description = spec;
+        order = std::move(cpus);
+        return true;
+    }
+
+    /// 策略名，即 configure() 接受的 spec
+    const std::string& name() const { return description; }
+
+    /// 绑定顺序；不绑定时为空
+    const std::vector<int>& cpu_order() const { return order; }
+
+    /// 第 slot 个测试线程绑定的 CPU，不绑定时为 -1
+    int cpu_for(int slot) const {
+        return order.empty() ? -1 : order[static_cast<size_t>(slot) % order.size()];
+    }
+
+    /**
+     * @brief 把当前线程绑定到第 slot 个位置；失败时只在第一次打印警告，线程照常运行
+     */
+    void pin_current_thread(int slot) const {
+        const int cpu = cpu_for(slot);
+        if (cpu < 0) {
+            return;
+        }
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0 && !warned.exchange(true)) {
+            std::cerr << "警告: 无法把线程绑定到 CPU " << cpu << "，后续线程不再提示" << std::endl;
+        }
+    }
+};
+
+/**
+ * @brief 包装线程函数：先按当前放置策略把线程绑定到第 slot 个位置，再调用 task
+ *
+ * 用法：threads.emplace_back(pinned(i, task), args...)
+ */
+template <typename Task>
+auto pinned(int slot, Task task) {
+    return [slot, task](auto&&... args) mutable {
+        ThreadPlacement::instance().pin_current_thread(slot);
+        return task(std::forward<decltype(args)>(args)...);
+    };
+}
+
+#endif // THREADPLACEMENT_H
@@ -0,0 +1,134 @@
+#ifndef THREADSAFECOUNTER_H
+#define THREADSAFECOUNTER_H
+
+#include <atomic>
+#include <type_traits>
+#include <utility>
+#include "LockPolicies.h"
+#include "LockProfiling.h"
+
+/**
+ * @brief 检测锁策略是否提供读锁 lock_shared()/unlock_shared()
+ */
+template <typename Lock, typename = void>
+struct has_shared_lock : std::false_type {};
+
+template <typename Lock>
+struct has_shared_lock<Lock, std::void_t<decltype(std::declval<Lock&>().lock_shared()),
+                                         decltype(std::declval<Lock&>().unlock_shared())>> : std::true_type {};
+
+/**
+ * @brief 以锁策略为模板参数的线程安全计数器
+ *
+ * 通用版本用 LockPolicy 保护一个普通 int；不基于锁的后端
+ * （例如 AtomicPolicy）通过对本模板做显式特化来提供实现。
+ * 所有快路径都定义在头文件中，increment() 没有跨编译单元调用开销。
+ *
+ * @tparam LockPolicy 提供 name()/lock()/unlock() 的锁策略，见 LockPolicies.h
+ */
+template <typename LockPolicy>
+class ThreadSafeCounter {
+private:
+    int shared_counter;               ///< 共享计数器
+    mutable CounterLock<LockPolicy> lock;   ///< 锁，mutable允许const成员函数加锁；开启剖析时带统计包装
+
+public:
+    ThreadSafeCounter() : shared_counter(0) {}
+
+    // 禁止拷贝构造和赋值操作
+    ThreadSafeCounter(const ThreadSafeCounter&) = delete;
+    ThreadSafeCounter& operator=(const ThreadSafeCounter&) = delete;
+
+    /**
+     * @brief 后端名称
+     */
+    static const char* name() { return LockPolicy::name(); }
+
+    /**
+     * @brief 访问底层锁，用于读取锁自带的统计信息
+     */
+    const LockPolicy& lock_policy() const { return unwrap_lock(lock); }
+
+    /**
+     * @brief 原子性地递增计数器
+     * @return 递增后的计数器值（在锁内读取）
+     */
+    int increment() {
+        lock.lock();
+        int value = ++shared_counter;
+        lock.unlock();
+        return value;
+    }
+
+    /**
+     * @brief 原子性地把计数器加上 delta
+     * @return 相加后的计数器值（在锁内读取）
+     */
+    int add(int delta) {
+        lock.lock();
+        int value = shared_counter += delta;
+        lock.unlock();
+        return value;
+    }
+
+    /**
+     * @brief 获取当前计数器值；锁策略提供读锁时读者之间可以并行
+     * @return 当前的计数器值
+     */
+    int get() const {
+        if constexpr (has_shared_lock<LockPolicy>::value) {
+            lock.lock_shared();
+            int temp = shared_counter;
+            lock.unlock_shared();
+            return temp;
+        } else {
+            lock.lock();
+            int temp = shared_counter;
+            lock.unlock();
+            return temp;
+        }
+    }
+};
+
+/**
+ * @brief std::atomic 后端的标签类型（对应 atomic/ 目录）
+ */
+struct AtomicPolicy {
+    static const char* name() { return "atomic"; }
+};
+
+/**
+ * @brief 基于 std::atomic<int>::fetch_add 的无锁计数器
+ */
+template <>
+class ThreadSafeCounter<AtomicPolicy> {
+private:
+    std::atomic<int> shared_counter;
+
+public:
+    ThreadSafeCounter() : shared_counter(0) {}
+
+    ThreadSafeCounter(const ThreadSafeCounter&) = delete;
+    ThreadSafeCounter& operator=(const ThreadSafeCounter&) = delete;
+
+    static const char* name() { return AtomicPolicy::name(); }
+
+    /**
+     * @brief 原子性地递增计数器
+     * @return 递增后的计数器值
+     */
+    int increment() { return shared_counter.fetch_add(1) + 1; }
+
+    /**
+     * @brief 原子性地把计数器加上 delta
+     * @return 相加后的计数器值
+     */
+    int add(int delta) { return shared_counter.fetch_add(delta) + delta; }
+
+    /**
+     * @brief 获取当前计数器值
+     */
+    int get() const { return shared_counter.load(); }
+};
+
+#endif // THREADSAFECOUNTER_H
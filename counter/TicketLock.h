@@ -0,0 +1,80 @@
+#ifndef TICKETLOCK_H
+#define TICKETLOCK_H
+
+#include <atomic>
+#include <sched.h>
+#include "Platform.h"
+
+/**
+ * @brief 公平的票据自旋锁策略，可替换 SpinLockPolicy (pthread_spinlock_t)
+ *
+ * 加锁时取号 (fetch_add next_ticket)，按号顺序进入，保证 FIFO 公平。
+ * 等待者每轮按与 now_serving 的距离做比例退避：排得越靠后，
+ * 两次读取之间 pause 的次数越多，从而减少对锁所在缓存行的读流量。
+ * 超订（线程数远超 CPU）时，前面的持号线程可能被调度出去：排队位置
+ * 不小于在线 CPU 数时，前面必然有线程没在运行，直接让出 CPU；
+ * 否则自旋预算耗尽后也让出 CPU，避免整个时间片都空转。
+ */
+class TicketLockPolicy {
+private:
+    std::atomic<unsigned> next_ticket;
+    std::atomic<unsigned> now_serving;
+
+public:
+    /// 每个排队位置对应的 pause 次数
+    static constexpr unsigned BACKOFF_PER_POSITION = 16;
+    /// 排队位置的退避上限，防止队列很长时单轮退避过久
+    static constexpr unsigned MAX_BACKOFF_POSITIONS = 64;
+    /// 累计 pause 次数超过该值后每轮都让出 CPU
+    static constexpr unsigned SPIN_BUDGET = 1u << 14;
+
+    static const char* name() { return "ticket"; }
+
+    TicketLockPolicy() : next_ticket(0), now_serving(0) {}
+
+    TicketLockPolicy(const TicketLockPolicy&) = delete;
+    TicketLockPolicy& operator=(const TicketLockPolicy&) = delete;
+
+    void lock() {
+        const unsigned ticket = next_ticket.fetch_add(1, std::memory_order_relaxed);
+        unsigned spun = 0;
+        for (;;) {
+            const unsigned serving = now_serving.load(std::memory_order_acquire);
+            if (serving == ticket) {
+                return;
+            }
+            unsigned position = ticket - serving;   // 无符号差值，计数回绕后仍正确
+            if (position >= online_cpus()) {
+                note_spin();
+                sched_yield();
+                continue;
+            }
+            if (position > MAX_BACKOFF_POSITIONS) {
+                position = MAX_BACKOFF_POSITIONS;
+            }
+            const unsigned pauses = position * BACKOFF_PER_POSITION;
+            for (unsigned i = 0; i < pauses; ++i) {
+                cpu_relax();
+            }
+            spun += pauses;
+            if (spun >= SPIN_BUDGET) {
+                note_spin();
+                sched_yield();
+            }
+        }
+    }
+
+    /**
+     * @brief 除持锁者外是否还有线程在排队；由持锁者在释放前调用
+     */
+    bool has_waiters() const {
+        return next_ticket.load(std::memory_order_relaxed) - now_serving.load(std::memory_order_relaxed) > 1;
+    }
+
+    void unlock() {
+        // 只有持锁者写 now_serving，读-加-写无需原子 RMW
+        now_serving.store(now_serving.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+};
+
+#endif // TICKETLOCK_H
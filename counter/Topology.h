@@ -0,0 +1,222 @@
+#ifndef TOPOLOGY_H
+#define TOPOLOGY_H
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <sched.h>
+
+/**
+ * @brief 解析 sysfs 的 CPU 列表格式，例如 "0-3,8-11" 或 "5"
+ */
+inline std::vector<int> parse_cpu_list(const std::string& text) {
+    std::vector<int> cpus;
+    std::stringstream in(text);
+    std::string range;
+    while (std::getline(in, range, ',')) {
+        if (range.empty() || range == "\n") {
+            continue;
+        }
+        int first = 0;
+        int last = 0;
+        char dash = 0;
+        std::stringstream item(range);
+        item >> first;
+        if (item >> dash && dash == '-' && item >> last) {
+            for (int cpu = first; cpu <= last; ++cpu) {
+                cpus.push_back(cpu);
+            }
+        } else {
+            cpus.push_back(first);
+        }
+    }
+    return cpus;
+}
+
+/**
+ * @brief 读取整个 sysfs 文件；文件不存在时返回 false
+ */
+inline bool read_sysfs(const std::string& path, std::string& content) {
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+    std::getline(file, content);
+    return true;
+}
+
+/**
+ * @brief 读取只含一个整数的 sysfs 文件；文件不存在、为空或格式不对时返回 false，value 不变
+ */
+inline bool read_sysfs_int(const std::string& path, int& value) {
+    std::string content;
+    if (!read_sysfs(path, content)) {
+        return false;
+    }
+    std::istringstream in(content);
+    int parsed = 0;
+    if (!(in >> parsed)) {
+        return false;
+    }
+    value = parsed;
+    return true;
+}
+
+/**
+ * @brief 从 /sys/devices/system/node 读取的 NUMA 拓扑
+ *
+ * sysfs 不可用（容器、非 NUMA 内核）时退化为单节点，所有 CPU 属于节点 0。
+ */
+class NumaTopology {
+private:
+    std::vector<int> cpu_to_node;
+    int nodes;
+
+    NumaTopology() : nodes(0) {
+        std::string content;
+        std::vector<int> online_nodes;
+        if (read_sysfs("/sys/devices/system/node/online", content)) {
+            online_nodes = parse_cpu_list(content);
+        }
+        for (int node : online_nodes) {
+            if (!read_sysfs("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist", content)) {
+                continue;
+            }
+            for (int cpu : parse_cpu_list(content)) {
+                if (cpu >= static_cast<int>(cpu_to_node.size())) {
+                    cpu_to_node.resize(cpu + 1, 0);
+                }
+                cpu_to_node[cpu] = node;
+            }
+            if (node + 1 > nodes) {
+                nodes = node + 1;
+            }
+        }
+        if (nodes == 0) {
+            nodes = 1;
+        }
+    }
+
+public:
+    static const NumaTopology& instance() {
+        static const NumaTopology topology;
+        return topology;
+    }
+
+    /// 节点数（按最大节点号 + 1 计算，至少为 1）
+    int num_nodes() const { return nodes; }
+
+    /// CPU 所在节点；未知 CPU 归入节点 0
+    int node_of_cpu(int cpu) const {
+        return (cpu >= 0 && cpu < static_cast<int>(cpu_to_node.size())) ? cpu_to_node[cpu] : 0;
+    }
+
+    /// 当前线程所在节点
+    int current_node() const { return node_of_cpu(sched_getcpu()); }
+};
+
+/**
+ * @brief 一个逻辑 CPU 在物理拓扑中的位置
+ */
+struct CpuLocation {
+    int cpu;
+    int package;        ///< 所在插槽 (physical_package_id)
+    int core;           ///< 插槽内第几个物理核，从 0 开始连续编号
+    int sibling;        ///< 物理核内第几个超线程，从 0 开始
+};
+
+/**
+ * @brief 从 /sys/devices/system/cpu 读取的插槽/物理核/超线程拓扑
+ *
+ * 只包含当前进程 CPU 亲和性掩码内的在线 CPU，容器里受限的 CPU 不会出现。
+ * sysfs 不可用时每个 CPU 视为单独插槽 0 上的一个物理核。
+ */
+class CpuTopology {
+private:
+    std::vector<CpuLocation> locations;
+    int packages;
+    int cores;
+
+    CpuTopology() : packages(0), cores(0) {
+        std::string content;
+        std::vector<int> online;
+        if (read_sysfs("/sys/devices/system/cpu/online", content)) {
+            online = parse_cpu_list(content);
+        }
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        const bool has_mask = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+        if (online.empty()) {
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                if (has_mask && CPU_ISSET(cpu, &allowed)) {
+                    online.push_back(cpu);
+                }
+            }
+        }
+
+        // (插槽, sysfs core_id) -> 插槽内连续编号与已见超线程数
+        struct CoreKey {
+            int package;
+            int core_id;
+            int index;
+            int siblings;
+        };
+        std::vector<CoreKey> seen;
+        for (int cpu : online) {
+            if (has_mask && (cpu >= CPU_SETSIZE || !CPU_ISSET(cpu, &allowed))) {
+                continue;
+            }
+            const std::string base = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/";
+            int package = 0;
+            int core_id = cpu;
+            // 读不到或内容不合法（部分容器、虚拟机中为空）时保持默认：插槽 0，每个 CPU 自成一核
+            read_sysfs_int(base + "physical_package_id", package);
+            package = std::max(package, 0);
+            read_sysfs_int(base + "core_id", core_id);
+            auto it = std::find_if(seen.begin(), seen.end(), [package, core_id](const CoreKey& key) {
+                return key.package == package && key.core_id == core_id;
+            });
+            if (it == seen.end()) {
+                const int index = static_cast<int>(std::count_if(seen.begin(), seen.end(), [package](const CoreKey& key) {
+                    return key.package == package;
+                }));
+                seen.push_back(CoreKey{package, core_id, index, 0});
+                it = seen.end() - 1;
+            }
+            locations.push_back(CpuLocation{cpu, package, it->index, it->siblings++});
+            packages = std::max(packages, package + 1);
+        }
+        cores = static_cast<int>(seen.size());
+        if (locations.empty()) {
+            locations.push_back(CpuLocation{0, 0, 0, 0});
+            cores = 1;
+        }
+        packages = std::max(packages, 1);
+    }
+
+public:
+    static const CpuTopology& instance() {
+        static const CpuTopology topology;
+        return topology;
+    }
+
+    /// 可用的逻辑 CPU，按 CPU 编号排序
+    const std::vector<CpuLocation>& cpus() const { return locations; }
+
+    /// 插槽数（按最大插槽号 + 1 计算，至少为 1）
+    int num_packages() const { return packages; }
+
+    /// 物理核数
+    int num_cores() const { return cores; }
+
+    /// 是否是可用的逻辑 CPU
+    bool contains(int cpu) const {
+        return std::any_of(locations.begin(), locations.end(), [cpu](const CpuLocation& location) {
+            return location.cpu == cpu;
+        });
+    }
+};
+
+#endif // TOPOLOGY_H
@@ -0,0 +1,104 @@
+#ifndef TRIALSTATISTICS_H
+#define TRIALSTATISTICS_H
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+/**
+ * @brief 同一场景多次试验的吞吐量统计
+ *
+ * 95% 置信区间按 t 分布计算：均值 ± t(0.975, n-1)·s/√n。
+ * 离群值用 Tukey 栅栏判定：低于 Q1 - 1.5·IQR 或高于 Q3 + 1.5·IQR，
+ * 至少 4 次试验才判定。离群值只报告，不从统计中剔除，中位数本身已不受其影响。
+ */
+struct TrialStatistics {
+    int warmups = 0;                ///< 不计入统计的预热次数
+    int trials = 0;                 ///< 计入统计的试验次数，0 表示未做多次试验
+    double mean = 0.0;
+    double median = 0.0;
+    double stddev = 0.0;            ///< 样本标准差（n-1）
+    double ci_low = 0.0;
+    double ci_high = 0.0;
+    std::vector<int> outliers;      ///< 离群试验的序号（从 0 开始）
+
+    /// 置信区间半宽相对均值的百分比；不足两次试验时为 -1
+    double ci_half_width_percent() const {
+        return trials >= 2 && mean > 0.0 ? 50.0 * (ci_high - ci_low) / mean : -1.0;
+    }
+};
+
+/**
+ * @brief 双侧 95% 置信区间的 t 分位数 t(0.975, dof)
+ *
+ * 自由度 1 到 30 查表，更大时用 Cornish-Fisher 展开近似，误差小于 0.001。
+ */
+inline double student_t_975(int dof) {
+    static const double table[] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+    if (dof < 1) {
+        return 0.0;
+    }
+    if (dof <= 30) {
+        return table[dof - 1];
+    }
+    const double z = 1.959964;
+    const double n = dof;
+    return z + (z * z * z + z) / (4 * n) + (5 * std::pow(z, 5) + 16 * z * z * z + 3 * z) / (96 * n * n);
+}
+
+/**
+ * @brief 已排序样本的第 q 分位数（线性插值，q 取 0 到 1）
+ */
+inline double sorted_quantile(const std::vector<double>& sorted, double q) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    const double position = q * (sorted.size() - 1);
+    const size_t lower = static_cast<size_t>(position);
+    const size_t upper = std::min(lower + 1, sorted.size() - 1);
+    return sorted[lower] + (position - lower) * (sorted[upper] - sorted[lower]);
+}
+
+inline TrialStatistics summarize_trials(const std::vector<double>& samples, int warmups = 0) {
+    TrialStatistics stats;
+    stats.warmups = warmups;
+    stats.trials = static_cast<int>(samples.size());
+    if (samples.empty()) {
+        return stats;
+    }
+    std::vector<double> sorted = samples;
+    std::sort(sorted.begin(), sorted.end());
+    stats.median = sorted_quantile(sorted, 0.5);
+
+    for (double sample : samples) {
+        stats.mean += sample;
+    }
+    stats.mean /= samples.size();
+    if (samples.size() >= 2) {
+        double squares = 0.0;
+        for (double sample : samples) {
+            squares += (sample - stats.mean) * (sample - stats.mean);
+        }
+        stats.stddev = std::sqrt(squares / (samples.size() - 1));
+    }
+    const double half_width = student_t_975(stats.trials - 1) * stats.stddev / std::sqrt(static_cast<double>(samples.size()));
+    stats.ci_low = stats.mean - half_width;
+    stats.ci_high = stats.mean + half_width;
+
+    if (samples.size() >= 4) {
+        const double q1 = sorted_quantile(sorted, 0.25);
+        const double q3 = sorted_quantile(sorted, 0.75);
+        const double fence = 1.5 * (q3 - q1);
+        for (size_t i = 0; i < samples.size(); ++i) {
+            if (samples[i] < q1 - fence || samples[i] > q3 + fence) {
+                stats.outliers.push_back(static_cast<int>(i));
+            }
+        }
+    }
+    return stats;
+}
+
+#endif // TRIALSTATISTICS_H
@@ -0,0 +1,238 @@
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "CpuUsage.h"
+#include "Futex.h"
+#include "PerfCounters.h"
+#include "Platform.h"
+#include "ThreadPlacement.h"
+
+/**
+ * @brief 一个线程在一次运行中的起止时刻（相对开闸时刻，单位纳秒）、CPU 用量与硬件计数
+ */
+struct ThreadTiming {
+    long long start_ns;
+    long long end_ns;
+    CpuUsage usage;                         ///< 同一区间内的 CPU 时间、上下文切换与 futex 调用
+    PerfSample counters;                    ///< 同一区间内的硬件计数，未开启或不可用时 threads 为 0
+};
+
+/**
+ * @brief 一次运行中所有参与线程的起止时刻
+ */
+struct RunTiming {
+    std::vector<ThreadTiming> threads;
+
+    /// 测量区间：最早开始到最晚结束；没有线程时为 0
+    long long duration_ns() const { return threads.empty() ? 0 : last_end() - first_start(); }
+
+    /// 最晚开始与最早开始之差，反映开闸后线程被调度的先后
+    long long start_skew_ns() const { return threads.empty() ? 0 : last_start() - first_start(); }
+
+    /// 最晚结束与最早结束之差，反映各线程工作量或调度的不均
+    long long end_skew_ns() const { return threads.empty() ? 0 : last_end() - first_end(); }
+
+    long long first_start() const { return extreme(&ThreadTiming::start_ns, false); }
+    long long last_start() const { return extreme(&ThreadTiming::start_ns, true); }
+    long long first_end() const { return extreme(&ThreadTiming::end_ns, false); }
+    long long last_end() const { return extreme(&ThreadTiming::end_ns, true); }
+
+    /// 各线程 CPU 用量之和
+    CpuUsage usage() const {
+        CpuUsage total;
+        for (const ThreadTiming& timing : threads) {
+            total.merge(timing.usage);
+        }
+        return total;
+    }
+
+    /// 各线程硬件计数之和
+    PerfSample counters() const {
+        PerfSample total;
+        for (const ThreadTiming& timing : threads) {
+            total.merge(timing.counters);
+        }
+        return total;
+    }
+
+    /// 线程 [first, last) 的起止区间，用于分别统计不同角色的线程
+    RunTiming slice(size_t first, size_t last) const {
+        RunTiming part;
+        part.threads.assign(threads.begin() + std::min(first, threads.size()), threads.begin() + std::min(last, threads.size()));
+        return part;
+    }
+
+private:
+    long long extreme(long long ThreadTiming::*field, bool largest) const {
+        long long value = threads.empty() ? 0 : threads.front().*field;
+        for (const ThreadTiming& timing : threads) {
+            value = largest ? std::max(value, timing.*field) : std::min(value, timing.*field);
+        }
+        return value;
+    }
+};
+
+/**
+ * @brief 预先创建并常驻的测试线程池，用开闸栅栏同时放出各线程
+ *
+ * run(n, task) 让前 n 个工作线程各执行一次 task(线程号)：工作线程先全部
+ * 就位，再由同一次开闸放行，每个线程只记录自己从放行到 task 返回的区间。
+ * 线程的创建、销毁与唤醒都不计入测量，因此 4 倍核数的超订测试测到的是
+ * 计数器本身，而不是几百次 clone/join。
+ *
+ * 工作线程按 ThreadPlacement 在创建时绑定到第 i 个位置，之后一直复用。
+ * 等待任务和等待开闸时多核上先自旋一小段，之后在 futex 上休眠，
+ * 空闲线程不占 CPU。
+ *
+ * 每个工作线程在 task 前后各读一次自己的 CPU 用量（CpuUsage）；
+ * PerfCounters 开启时每个工作线程第一次接到任务时打开自己的硬件计数器，
+ * 之后每次运行只在 task 前后启停，计数区间与记录的起止时刻一致。
+ *
+ * 线程不退出，依赖线程退出回调（ThreadExitHooks）结算的场景仍需自建线程。
+ */
+class WorkerPool {
+private:
+    struct alignas(CACHE_LINE_SIZE) Worker {
+        std::atomic<int> job{0};            ///< 每分配一次任务加 1，工作线程在其上等待
+        std::chrono::steady_clock::time_point start;
+        std::chrono::steady_clock::time_point end;
+        CpuUsage usage;                     ///< 本次 task 期间的用量，由该工作线程写入
+        PerfCounters perf;                  ///< 只由该工作线程打开和启停
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::function<void(int)> task;
+    int participants = 0;
+    int closed_gate = 0;                    ///< 本次运行开闸前 gate 的值
+    std::chrono::steady_clock::time_point gate_time;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<int> ready{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<int> gate{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<int> finished{0};
+
+    WorkerPool() = default;
+
+    /// 等到 word 不再等于 value：多核时先自旋 SPIN_YIELD_THRESHOLD 轮，仍未变化则在 futex 上休眠
+    static int wait_while_equal(std::atomic<int>& word, int value) {
+        unsigned spun = 0;
+        int current;
+        while ((current = word.load(std::memory_order_acquire)) == value) {
+            if (online_cpus() > 1 && ++spun <= SPIN_YIELD_THRESHOLD) {
+                cpu_relax();
+            } else {
+                futex_wait(&word, value);
+            }
+        }
+        return current;
+    }
+
+    [[noreturn]] void worker_loop(Worker& worker, int index) {
+        int seen = 0;
+        for (;;) {
+            seen = wait_while_equal(worker.job, seen);
+            // 主线程在最后一个线程完成后就可能开始下一次运行，这里先取本次的参数
+            const int expected = participants;
+            if (PerfCounters::enabled()) {
+                worker.perf.open();
+            }
+            if (ready.fetch_add(1, std::memory_order_acq_rel) + 1 == expected) {
+                futex_wake(&ready, 1);
+            }
+            wait_while_equal(gate, closed_gate);
+            const CpuUsage before = thread_cpu_usage();
+            worker.perf.start();
+            worker.start = std::chrono::steady_clock::now();
+            task(index);
+            worker.end = std::chrono::steady_clock::now();
+            worker.perf.stop();
+            worker.usage = thread_cpu_usage().since(before);
+            if (finished.fetch_add(1, std::memory_order_acq_rel) + 1 == expected) {
+                futex_wake(&finished, 1);
+            }
+        }
+    }
+
+    /// 主线程等待 counter 达到 target；counter 只增不减
+    static void wait_for_count(std::atomic<int>& counter, int target) {
+        int current;
+        while ((current = counter.load(std::memory_order_acquire)) < target) {
+            futex_wait(&counter, current);
+        }
+    }
+
+public:
+    /// 进程级线程池；工作线程在进程退出时随进程结束，不参与静态对象析构
+    static WorkerPool& instance() {
+        static WorkerPool* pool = new WorkerPool();
+        return *pool;
+    }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /// 已创建的工作线程数
+    int size() const { return static_cast<int>(workers.size()); }
+
+    /**
+     * @brief 放出前 threads 个工作线程执行 body(线程号)，在全部就位并开闸后返回
+     *
+     * 返回后调用者可以在主线程上计时、休眠或设置停止标志，最后必须调用 wait()。
+     * 工作线程不足时先补足（不计入测量）。
+     */
+    void launch(int threads, std::function<void(int)> body) {
+        threads = std::max(threads, 0);
+        while (size() < threads) {
+            const int index = size();
+            workers.emplace_back(new Worker());
+            Worker& worker = *workers.back();
+            std::thread(pinned(index, [this, &worker, index]() { worker_loop(worker, index); })).detach();
+        }
+        task = std::move(body);
+        participants = threads;
+        closed_gate = gate.load(std::memory_order_relaxed);
+        ready.store(0, std::memory_order_relaxed);
+        finished.store(0, std::memory_order_relaxed);
+        for (int i = 0; i < threads; ++i) {
+            workers[i]->job.fetch_add(1, std::memory_order_release);
+            futex_wake(&workers[i]->job, 1);
+        }
+        wait_for_count(ready, threads);
+        gate_time = std::chrono::steady_clock::now();
+        gate.fetch_add(1, std::memory_order_release);
+        futex_wake_all(&gate);
+    }
+
+    /**
+     * @brief 等待 launch() 放出的线程全部结束，返回各线程的起止时刻、CPU 用量与硬件计数（按线程号排列）
+     */
+    RunTiming wait() {
+        wait_for_count(finished, participants);
+        RunTiming timing;
+        for (int i = 0; i < participants; ++i) {
+            const Worker& worker = *workers[i];
+            timing.threads.push_back(ThreadTiming{
+                std::chrono::duration_cast<std::chrono::nanoseconds>(worker.start - gate_time).count(),
+                std::chrono::duration_cast<std::chrono::nanoseconds>(worker.end - gate_time).count(),
+                worker.usage, worker.perf.read()});
+        }
+        task = nullptr;
+        return timing;
+    }
+
+    /**
+     * @brief launch() 加 wait()：threads 个线程同时开始执行 body(线程号)
+     */
+    RunTiming run(int threads, std::function<void(int)> body) {
+        launch(threads, std::move(body));
+        return wait();
+    }
+};
+
+#endif // WORKERPOOL_H
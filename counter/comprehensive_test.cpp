@@ -0,0 +1,2462 @@
+// comprehensive_stress_test.cpp
+// 在同一个进程中对所有 ThreadSafeCounter<LockPolicy> 后端运行全部场景，并并排对比结果
+#include "ThreadSafeCounter.h"
+#include "StripedCounter.h"
+#include "PerCpuCounter.h"
+#include "TicketLock.h"
+#include "McsLock.h"
+#include "CohortLock.h"
+#include "FutexMutex.h"
+#include "ParkingLot.h"
+#include "PhaseFairRwLock.h"
+#include "SeqlockStatistics.h"
+#include "FlatCombining.h"
+#include "CountingNetwork.h"
+#include "SloppyCounter.h"
+#include "IdAllocator.h"
+#include "AtomicUpdate.h"
+#include "LatencyHistogram.h"
+#include "BenchmarkReport.h"
+#include "ThreadPlacement.h"
+#include "WorkerPool.h"
+#include "PerfCounters.h"
+#include "CpuUsage.h"
+#include "ScalabilityModel.h"
+#include "TrialStatistics.h"
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <iomanip>
+#include <cassert>
+#include <string>
+#include <sstream>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <type_traits>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <cstdlib>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <unistd.h>
+
+// 压力测试结果结构体
+struct StressTestResult {
+    std::string test_name;
+    long long duration_ms;
+    int expected_count;
+    int actual_count;
+    bool passed;
+    size_t total_operations;
+    double throughput_ops_per_sec;
+    std::string backend;
+    double fairness_index = 0.0;      ///< Jain 公平性指数，仅公平性测试填写（1.0 为完全公平）
+    double max_min_ratio = 0.0;       ///< 获取次数最多/最少线程之比，仅公平性测试填写
+    size_t memory_bytes = 0;          ///< 计数器占用的内存，仅计数器数组测试填写
+    long max_read_error = -1;         ///< get() 落后于已完成递增数的最大值，仅长时间稳定性测试填写
+    double cas_failure_rate = -1.0;   ///< CAS 失败次数 / CAS 尝试次数，仅 CAS 退避测试填写
+    LatencySummary increment_latency{};///< increment() 的延迟百分位，未测量时 samples 为 0
+    LatencySummary get_latency{};     ///< get() 的延迟百分位，未测量时 samples 为 0
+    std::string placement = ThreadPlacement::instance().name();  ///< 运行时的线程放置策略
+    RunTiming timing{};               ///< 各线程的起止时刻，仅经由 WorkerPool 运行的场景填写
+    TrialStatistics trials{};         ///< 多次试验的吞吐量统计，此时 throughput_ops_per_sec 为中位数
+};
+
+/**
+ * 打印后端自带的统计信息；默认无，需要的后端提供重载
+ */
+template <typename Counter>
+void print_backend_details(const Counter&) {}
+
+inline void print_backend_details(const ThreadSafeCounter<CohortLockPolicy>& counter) {
+    const CohortLockStats& stats = counter.lock_policy().stats();
+    const unsigned long handoffs = stats.same_node_handoffs + stats.cross_node_handoffs;
+    std::cout << "NUMA 节点数: " << counter.lock_policy().nodes() << std::endl;
+    std::cout << "锁交接: 同节点 " << stats.same_node_handoffs << "，跨节点 " << stats.cross_node_handoffs;
+    if (handoffs > 0) {
+        std::cout << " (同节点占比 " << std::fixed << std::setprecision(2)
+                  << 100.0 * stats.same_node_handoffs / handoffs << "%)";
+    }
+    std::cout << std::endl;
+    std::cout << "释放方式: 节点内传递 " << stats.local_passes << "，归还全局锁 " << stats.global_releases << std::endl;
+}
+
+/**
+ * 打印并清空锁竞争剖析；未定义 COUNTER_LOCK_PROFILING 时什么也不做
+ */
+inline void print_lock_profile() {
+#ifdef COUNTER_LOCK_PROFILING
+    LockProfiler::instance().dump(std::cout);
+    LockProfiler::instance().reset();
+    std::cout << std::endl;
+#endif
+}
+
+/// 每隔多少次操作采一个延迟样本；只给一部分操作计时，计时开销不会明显拉低吞吐量
+constexpr unsigned LATENCY_SAMPLE_INTERVAL = 8;
+
+/**
+ * 执行第 op_index 次操作；落在采样点上时计时并记入 histogram
+ */
+template <typename Op>
+inline auto sampled_operation(LatencyHistogram& histogram, long op_index, Op&& op) -> decltype(op()) {
+    if (op_index % LATENCY_SAMPLE_INTERVAL == 0) {
+        return timed_operation(histogram, op);
+    }
+    return op();
+}
+
+/**
+ * 合并各线程的直方图，打印 p50/p90/p99/p99.9/max，返回摘要；没有样本时不打印
+ */
+inline LatencySummary print_latency(const char* label, const std::vector<LatencyHistogram>& per_thread) {
+    LatencyHistogram merged;
+    for (const auto& histogram : per_thread) {
+        merged.merge(histogram);
+    }
+    LatencySummary summary = merged.summary();
+    if (summary.samples > 0) {
+        std::cout << label << " 延迟(ns): p50 " << summary.p50 << "，p90 " << summary.p90 << "，p99 " << summary.p99
+                  << "，p99.9 " << summary.p999 << "，max " << summary.max << " (样本 " << summary.samples
+                  << "，已扣除计时开销 " << timer_overhead_ns() << " ns)" << std::endl;
+    }
+    return summary;
+}
+
+/**
+ * 按测量区间（最早开始到最晚结束）计算吞吐量
+ */
+inline double ops_per_second(size_t operations, const RunTiming& timing) {
+    const long long ns = timing.duration_ns();
+    return ns > 0 ? operations * 1e9 / ns : 0.0;
+}
+
+/**
+ * 打印各线程开始与结束时刻的偏差；偏差大说明线程没有真正同时竞争。
+ * 随后打印测量区间内的 CPU 时间、上下文切换、futex 调用（跟踪点不可用时为 n/a）与每 CPU 秒操作数，
+ * 有硬件计数时再打印每次操作的周期、指令（及 IPC）、缓存缺失与 HITM
+ */
+inline void print_run_timing(const RunTiming& timing, size_t operations) {
+    std::cout << "线程起止偏差(us): 开始 " << std::fixed << std::setprecision(1) << timing.start_skew_ns() / 1000.0
+              << "，结束 " << timing.end_skew_ns() / 1000.0 << " (" << timing.threads.size() << " 线程，测量区间 "
+              << timing.duration_ns() / 1000.0 << " us)" << std::endl;
+    const CpuUsage usage = timing.usage();
+    const PerfSample counters = timing.counters();
+    if (usage.threads > 0) {
+        std::cout << "CPU 时间(ms): " << std::setprecision(2) << usage.cpu_ns / 1e6 << " (用户 " << usage.user_ns / 1e6
+                  << "，系统 " << usage.sys_ns / 1e6 << ")；上下文切换: 自愿 " << usage.voluntary_switches << "，非自愿 " << usage.involuntary_switches
+                  << "；futex 调用 ";
+        // 跟踪点打不开时次数未知，不能报 0
+        if (counters.available(PERF_FUTEX_CALLS)) {
+            std::cout << std::setprecision(0) << counters.counts[PERF_FUTEX_CALLS];
+        } else {
+            std::cout << "n/a";
+        }
+        std::cout << "；每 CPU 秒操作数 " << std::setprecision(0) << usage.operations_per_cpu_second(operations) << std::endl;
+    }
+    bool hardware = false;
+    for (int kind = 0; kind < PERF_EVENT_KINDS; ++kind) {
+        hardware = hardware || (kind != PERF_FUTEX_CALLS && counters.available(kind));
+    }
+    if (!hardware || operations == 0) {
+        return;
+    }
+    std::cout << "硬件计数/操作:" << std::setprecision(2);
+    for (int kind = 0; kind < PERF_EVENT_KINDS; ++kind) {
+        if (kind != PERF_FUTEX_CALLS && counters.available(kind)) {
+            std::cout << " " << perf_event_name(kind) << " " << counters.per_operation(kind, operations);
+        }
+    }
+    if (counters.available(PERF_CYCLES) && counters.available(PERF_INSTRUCTIONS) && counters.counts[PERF_CYCLES] > 0) {
+        std::cout << " (IPC " << counters.counts[PERF_INSTRUCTIONS] / counters.counts[PERF_CYCLES] << ")";
+    }
+    std::cout << std::endl;
+}
+
+/**
+ * 所有工作线程结束后的计数值；线程池中的线程不退出，粗略计数器的局部增量
+ * 不会在退出时刷入，需要读精确值
+ */
+template <typename Counter>
+int settled_value(const Counter& counter) { return counter.get(); }
+
+template <unsigned Threshold>
+int settled_value(const ThreadSafeCounter<SloppyPolicy<Threshold>>& counter) { return counter.get_exact(); }
+
+/**
+ * 预热与重复试验的设置，来自命令行 --warmup / --trials / --ci-target / --max-trials
+ */
+struct TrialSettings {
+    int warmups = 0;                  ///< 每个场景正式试验前丢弃的运行次数
+    int trials = 1;                   ///< 每个场景至少试验的次数
+    double ci_target_percent = 0.0;   ///< 大于 0 时继续试验，直到 95% CI 半宽不超过均值的该百分比
+    int max_trials = 30;              ///< 按置信区间追加试验时的上限
+};
+
+inline TrialSettings& trial_settings() {
+    static TrialSettings settings;
+    return settings;
+}
+
+/**
+ * 在作用域内丢弃 std::cout 的输出：预热与第二次起的试验只保留统计结果
+ */
+class QuietOutput {
+private:
+    struct NullBuffer : std::streambuf {
+        int overflow(int c) override { return c; }
+    };
+    NullBuffer sink;
+    std::streambuf* saved;
+
+public:
+    QuietOutput() : saved(std::cout.rdbuf(&sink)) {}
+    ~QuietOutput() { std::cout.rdbuf(saved); }
+    QuietOutput(const QuietOutput&) = delete;
+    QuietOutput& operator=(const QuietOutput&) = delete;
+};
+
+/**
+ * 按 trial_settings() 运行一个场景：先静默预热，再做多次试验并统计吞吐量
+ *
+ * run() 每次都要构造新的计数器并返回一次完整的结果。第一次试验照常打印明细，
+ * 之后的试验只汇总为一行统计。返回吞吐量最接近中位数的那次结果，
+ * 吞吐量替换为中位数；任一次试验失败则整个结果失败。
+ * 默认设置（不预热、只试验一次）下与直接调用 run() 相同。
+ */
+template <typename Run>
+StressTestResult run_trials(Run run) {
+    const TrialSettings& settings = trial_settings();
+    if (settings.warmups == 0 && settings.trials <= 1 && settings.ci_target_percent <= 0.0) {
+        return run();
+    }
+    for (int i = 0; i < settings.warmups; ++i) {
+        QuietOutput quiet;
+        run();
+    }
+
+    // 按置信区间追加时至少 3 次，样本太少时 t 分位数很大，区间没有意义
+    const size_t minimum = static_cast<size_t>(std::max(settings.trials, settings.ci_target_percent > 0.0 ? 3 : 1));
+    std::vector<StressTestResult> results;
+    std::vector<double> samples;
+    TrialStatistics stats;
+    for (;;) {
+        if (results.empty()) {
+            results.push_back(run());
+        } else {
+            QuietOutput quiet;
+            results.push_back(run());
+        }
+        samples.push_back(results.back().throughput_ops_per_sec);
+        stats = summarize_trials(samples, settings.warmups);
+        if (samples.size() < minimum) {
+            continue;
+        }
+        const double width = stats.ci_half_width_percent();
+        if (settings.ci_target_percent <= 0.0 || samples.size() >= static_cast<size_t>(settings.max_trials) ||
+            (width >= 0.0 && width <= settings.ci_target_percent)) {
+            break;
+        }
+    }
+
+    size_t representative = 0;
+    int failures = 0;
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (std::abs(samples[i] - stats.median) < std::abs(samples[representative] - stats.median)) {
+            representative = i;
+        }
+        failures += results[i].passed ? 0 : 1;
+    }
+    StressTestResult result = results[representative];
+    result.throughput_ops_per_sec = stats.median;
+    result.passed = failures == 0;
+    result.trials = stats;
+
+    const double width = stats.ci_half_width_percent();
+    std::cout << "📊 试验统计 (预热 " << stats.warmups << " 次，试验 " << stats.trials << " 次): 吞吐量中位数 "
+              << std::fixed << std::setprecision(0) << stats.median << "，均值 " << stats.mean << "，标准差 " << stats.stddev;
+    if (stats.trials >= 2) {
+        std::cout << " (CV " << std::setprecision(2) << 100.0 * stats.stddev / stats.mean << "%)，95% CI ["
+                  << std::setprecision(0) << stats.ci_low << ", " << stats.ci_high << "] (±" << std::setprecision(2)
+                  << width << "%)";
+    }
+    if (!stats.outliers.empty()) {
+        std::cout << "，离群试验:";
+        for (int index : stats.outliers) {
+            std::cout << " #" << index + 1 << "(" << std::setprecision(0) << samples[index] << ")";
+        }
+    }
+    std::cout << std::endl;
+    if (settings.ci_target_percent > 0.0 && (width < 0.0 || width > settings.ci_target_percent)) {
+        std::cout << "⚠️ 已达 " << settings.max_trials << " 次试验上限，置信区间 ±" << std::setprecision(2) << width
+                  << "% 仍宽于目标 ±" << settings.ci_target_percent << "%" << std::endl;
+    }
+    if (failures > 0) {
+        std::cout << "❌ " << failures << " 次试验失败" << std::endl;
+    }
+    std::cout << std::endl;
+    return result;
+}
+
+/**
+ * 基础压力测试：验证正确性并测量性能
+ */
+template <typename Counter>
+StressTestResult basic_stress_test(Counter& counter, int num_threads, int increments_per_thread, const std::string& test_name) {
+    std::cout << "=== " << test_name << " [" << Counter::name() << "] ===" << std::endl;
+    std::cout << "配置: " << num_threads << " 线程 × " << increments_per_thread << " 次递增" << std::endl;
+
+    std::vector<LatencyHistogram> increment_latency(num_threads);
+    timer_overhead_ns();
+
+    // 池中线程全部就位后同时开始，只计它们各自执行的区间
+    RunTiming timing = WorkerPool::instance().run(num_threads, [&counter, &increment_latency, increments_per_thread](int thread) {
+        LatencyHistogram& histogram = increment_latency[thread];
+        for (int i = 0; i < increments_per_thread; ++i) {
+            sampled_operation(histogram, i, [&counter]() { return counter.increment(); });
+        }
+    });
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::nanoseconds(timing.duration_ns()));
+
+    int final_count = settled_value(counter);
+    int expected_count = num_threads * increments_per_thread;
+    bool test_passed = (final_count == expected_count);
+    size_t total_ops = num_threads * increments_per_thread;
+    double throughput = ops_per_second(total_ops, timing);
+
+    std::cout << "实际计数: " << final_count << std::endl;
+    std::cout << "预期计数: " << expected_count << std::endl;
+    std::cout << "耗时: " << duration.count() << " ms" << std::endl;
+    std::cout << "吞吐量: " << std::fixed << std::setprecision(2) << throughput << " 操作/秒" << std::endl;
+    print_run_timing(timing, total_ops);
+    LatencySummary latency = print_latency("increment()", increment_latency);
+    print_backend_details(counter);
+    std::cout << (test_passed ? "✅ 测试通过" : "❌ 测试失败") << "\n" << std::endl;
+
+    StressTestResult result = {test_name, duration.count(), expected_count, final_count, test_passed, total_ops, throughput, Counter::name()};
+    result.increment_latency = latency;
+    result.timing = timing;
+    return result;
+}
+
+/**
+ * 混合读写压力测试：模拟真实场景，同时有读写操作
+ */
+template <typename Counter>
+StressTestResult mixed_read_write_stress_test(Counter& counter, int num_writer_threads, int writes_per_writer, int num_reader_threads, int reads_per_reader) {
+    std::string test_name = "混合读写压力测试";
+    std::cout << "=== " << test_name << " [" << Counter::name() << "] ===" << std::endl;
+    std::cout << "写线程: " << num_writer_threads << " × " << writes_per_writer << " 次写入" << std::endl;
+    std::cout << "读线程: " << num_reader_threads << " × " << reads_per_reader << " 次读取" << std::endl;
+
+    std::atomic<int> writers_running{num_writer_threads};
+    std::atomic<int> read_errors{0};
+    std::atomic<long> total_reads{0};
+    std::atomic<int> last_read_value{0};
+    int initial_count = counter.get();
+    std::vector<LatencyHistogram> increment_latency(num_writer_threads);
+    std::vector<LatencyHistogram> get_latency(num_reader_threads);
+    timer_overhead_ns();
+
+    // 写线程：每次写入后模拟一点工作量，全部写完后读线程随之停止
+    auto writer_task = [&counter, &increment_latency, &writers_running, writes_per_writer](int thread) {
+        LatencyHistogram& histogram = increment_latency[thread];
+        for (int i = 0; i < writes_per_writer; ++i) {
+            sampled_operation(histogram, i, [&counter]() { return counter.increment(); });
+            std::this_thread::sleep_for(std::chrono::microseconds(1));
+        }
+        writers_running.fetch_sub(1, std::memory_order_release);
+    };
+
+    // 读线程
+    auto reader_task = [&counter, &read_errors, &total_reads, &last_read_value, &get_latency, reads_per_reader, &writers_running](int thread) {
+        LatencyHistogram& histogram = get_latency[thread];
+        for (int j = 0; j < reads_per_reader && writers_running.load(std::memory_order_acquire) > 0; ++j) {
+            int value = sampled_operation(histogram, j, [&counter]() { return counter.get(); });
+            total_reads++;
+            last_read_value = value;
+
+            // 基本合理性检查：值不应为负
+            if (value < 0) {
+                read_errors++;
+            }
+
+            // 短暂睡眠，模拟读操作处理
+            std::this_thread::sleep_for(std::chrono::microseconds(2));
+        }
+    };
+
+    // 线程号 [0, 写线程数) 为写线程，其余为读线程
+    RunTiming timing = WorkerPool::instance().run(num_writer_threads + num_reader_threads,
+                                                  [&writer_task, &reader_task, num_writer_threads](int thread) {
+        if (thread < num_writer_threads) {
+            writer_task(thread);
+        } else {
+            reader_task(thread - num_writer_threads);
+        }
+    });
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::nanoseconds(timing.duration_ns()));
+
+    int final_count = settled_value(counter);
+    int expected_writes = num_writer_threads * writes_per_writer;
+    int expected_final_count = initial_count + expected_writes;
+    bool test_passed = (final_count == expected_final_count) && (read_errors == 0);
+
+    size_t total_ops = expected_writes + total_reads;
+    double throughput = ops_per_second(total_ops, timing);
+
+    std::cout << "初始计数: " << initial_count << std::endl;
+    std::cout << "实际最终计数: " << final_count << std::endl;
+    std::cout << "预期最终计数: " << expected_final_count << std::endl;
+    std::cout << "总读取次数: " << total_reads << std::endl;
+    std::cout << "读取错误数: " << read_errors << std::endl;
+    std::cout << "耗时: " << duration.count() << " ms" << std::endl;
+    std::cout << "吞吐量: " << std::fixed << std::setprecision(2) << throughput << " 操作/秒" << std::endl;
+    print_run_timing(timing, total_ops);
+    LatencySummary increment_summary = print_latency("increment()", increment_latency);
+    LatencySummary get_summary = print_latency("get()", get_latency);
+    std::cout << (test_passed ? "✅ 测试通过" : "❌ 测试失败") << "\n" << std::endl;
+
+    StressTestResult result = {test_name, duration.count(), expected_final_count, final_count, test_passed, total_ops, throughput, Counter::name()};
+    result.increment_latency = increment_summary;
+    result.get_latency = get_summary;
+    result.timing = timing;
+    return result;
+}
+
+/**
+ * 混合读写压力测试（统计对象版）：写者不断 record()，读者不断取快照并校验一致性
+ *
+ * 写者每次都记录 1，因此任何一致的快照都满足 sum == count、min == max == 1
+ * （count 为 0 时 sum == 0），且同一读者看到的 count 与时间戳单调不减；
+ * 只要读到写了一半的字段，这些不变式就会被破坏。
+ */
+template <typename WriterLock>
+StressTestResult mixed_read_write_stress_test(SeqlockStatistics<WriterLock>& stats, int num_writer_threads, int writes_per_writer, int num_reader_threads) {
+    std::string test_name = "混合读写(seqlock统计快照)";
+    std::cout << "=== " << test_name << " [" << SeqlockStatistics<WriterLock>::name() << "] ===" << std::endl;
+    std::cout << "写线程: " << num_writer_threads << " × " << writes_per_writer << " 次记录" << std::endl;
+    std::cout << "读线程: " << num_reader_threads << " 个，持续读取快照直到写线程结束" << std::endl;
+
+    std::atomic<int> writers_running{num_writer_threads};
+    std::atomic<long> torn_snapshots{0};
+    std::atomic<long> total_reads{0};
+    std::atomic<unsigned long> total_retries{0};
+
+    auto writer_task = [&stats, &writers_running, writes_per_writer]() {
+        for (int j = 0; j < writes_per_writer; ++j) {
+            stats.record(1);
+        }
+        writers_running.fetch_sub(1, std::memory_order_release);
+    };
+
+    auto reader_task = [&stats, &writers_running, &torn_snapshots, &total_reads, &total_retries]() {
+        long reads = 0;
+        long torn = 0;
+        unsigned long retries = 0;
+        long long last_count = 0;
+        long long last_timestamp = 0;
+        while (writers_running.load(std::memory_order_acquire) > 0) {
+            StatisticsSnapshot snap = stats.snapshot(&retries);
+            ++reads;
+            bool consistent = (snap.count == 0)
+                ? (snap.sum == 0 && snap.last_updated_ns == 0)
+                : (snap.sum == snap.count && snap.min == 1 && snap.max == 1);
+            consistent = consistent && snap.count >= last_count && snap.last_updated_ns >= last_timestamp;
+            if (!consistent) {
+                ++torn;
+            }
+            last_count = snap.count;
+            last_timestamp = snap.last_updated_ns;
+        }
+        total_reads += reads;
+        torn_snapshots += torn;
+        total_retries += retries;
+    };
+
+    // 线程号 [0, 写线程数) 为写线程，其余为读线程
+    RunTiming timing = WorkerPool::instance().run(num_writer_threads + num_reader_threads,
+                                                  [&writer_task, &reader_task, num_writer_threads](int thread) {
+        if (thread < num_writer_threads) {
+            writer_task();
+        } else {
+            reader_task();
+        }
+    });
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::nanoseconds(timing.duration_ns()));
+    const long long write_ns = timing.slice(0, num_writer_threads).last_end() - timing.first_start();
+
+    StatisticsSnapshot final_snapshot = stats.snapshot();
+    int expected_writes = num_writer_threads * writes_per_writer;
+    bool test_passed = (final_snapshot.count == expected_writes) && (final_snapshot.sum == expected_writes)
+                       && (torn_snapshots == 0);
+    size_t total_ops = expected_writes + total_reads;
+    double throughput = ops_per_second(total_ops, timing);
+
+    std::cout << "最终快照: count=" << final_snapshot.count << " sum=" << final_snapshot.sum
+              << " min=" << final_snapshot.min << " max=" << final_snapshot.max << std::endl;
+    std::cout << "预期记录次数: " << expected_writes << std::endl;
+    std::cout << "总读取次数: " << total_reads << "，重试次数: " << total_retries << std::endl;
+    std::cout << "撕裂快照数: " << torn_snapshots << std::endl;
+    std::cout << "耗时: " << duration.count() << " ms" << std::endl;
+    if (write_ns > 0) {
+        std::cout << "写吞吐量: " << std::fixed << std::setprecision(2) << expected_writes * 1e9 / write_ns
+                  << " 次/秒，读吞吐量: " << total_reads * 1e9 / write_ns << " 次/秒" << std::endl;
+    }
+    std::cout << "吞吐量: " << std::fixed << std::setprecision(2) << throughput << " 操作/秒" << std::endl;
+    print_run_timing(timing, total_ops);
+    std::cout << (test_passed ? "✅ 测试通过" : "❌ 测试失败") << "\n" << std::endl;
+
+    StressTestResult result = {test_name, duration.count(), expected_writes, static_cast<int>(final_snapshot.count), test_passed,
+                               total_ops, throughput, SeqlockStatistics<WriterLock>::name()};
+    result.timing = timing;
+    return result;
+}
+
+/**
+ * 按比例混合读写测试：每次操作以 read_percent% 的概率调用 get()，否则 increment()，
+ * 不休眠，测量读多/写多时读者能否并行
+ */
+template <typename Counter>
+StressTestResult mixed_ratio_stress_test(Counter& counter, int num_threads, int ops_per_thread, int read_percent) {
+    std::string test_name = "混合读写(读:写=" + std::to_string(read_percent) + ":" + std::to_string(100 - read_percent) + ")";
+    std::cout << "=== " << test_name << " [" << Counter::name() << "] ===" << std::endl;
+    std::cout << "配置: " << num_threads << " 线程 × " << ops_per_thread << " 次操作" << std::endl;
+
+    std::atomic<long> total_reads{0};
+    std::atomic<long> total_writes{0};
+    std::atomic<int> read_errors{0};
+    int initial_count = counter.get();
+    std::vector<LatencyHistogram> increment_latency(num_threads);
+    std::vector<LatencyHistogram> get_latency(num_threads);
+    timer_overhead_ns();
+
+    RunTiming timing = WorkerPool::instance().run(num_threads, [&counter, &total_reads, &total_writes, &read_errors, &increment_latency, &get_latency, ops_per_thread, read_percent](int i) {
+        LatencyHistogram& increment_histogram = increment_latency[i];
+        LatencyHistogram& get_histogram = get_latency[i];
+        unsigned long long state = 0x9E3779B97F4A7C15ull * (i + 1);
+        long reads = 0;
+        long writes = 0;
+        for (int j = 0; j < ops_per_thread; ++j) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            if (static_cast<int>(state % 100) < read_percent) {
+                if (sampled_operation(get_histogram, reads, [&counter]() { return counter.get(); }) < 0) {
+                    read_errors++;
+                }
+                ++reads;
+            } else {
+                sampled_operation(increment_histogram, writes, [&counter]() { return counter.increment(); });
+                ++writes;
+            }
+        }
+        total_reads += reads;
+        total_writes += writes;
+    });
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::nanoseconds(timing.duration_ns()));
+
+    int final_count = settled_value(counter);
+    int expected_final_count = initial_count + static_cast<int>(total_writes.load());
+    bool test_passed = (final_count == expected_final_count) && (read_errors == 0);
+    size_t total_ops = static_cast<size_t>(total_reads + total_writes);
+    double throughput = ops_per_second(total_ops, timing);
+
+    std::cout << "读取次数: " << total_reads << "，写入次数: " << total_writes << std::endl;
+    std::cout << "实际最终计数: " << final_count << std::endl;
+    std::cout << "预期最终计数: " << expected_final_count << std::endl;
+    std::cout << "耗时: " << duration.count() << " ms" << std::endl;
+    std::cout << "吞吐量: " << std::fixed << std::setprecision(2) << throughput << " 操作/秒" << std::endl;
+    std::cout << "读吞吐量: " << ops_per_second(static_cast<size_t>(total_reads), timing) << " 次/秒，写吞吐量: "
+              << ops_per_second(static_cast<size_t>(total_writes), timing) << " 次/秒" << std::endl;
+    print_run_timing(timing, total_ops);
+    LatencySummary increment_summary = print_latency("increment()", increment_latency);
+    LatencySummary get_summary = print_latency("get()", get_latency);
+    std::cout << (test_passed ? "✅ 测试通过" : "❌ 测试失败") << "\n" << std::endl;
+
+    StressTestResult result = {test_name, duration.count(), expected_final_count, final_count, test_passed, total_ops, throughput, Counter::name()};
+    result.increment_latency = increment_summary;
+    result.get_latency = get_summary;
+    result.timing = timing;
+    return result;
+}
+
+/**
+ * 极限压力测试：创建远超CPU核心数的线程
+ */
+template <typename Counter>
+StressTestResult extreme_stress_test(Counter& counter) {
+    // 创建大量线程，远超CPU核心数
+    const unsigned int hardware_concurrency = std::thread::hardware_concurrency();
+    const int num_threads = (hardware_concurrency > 0) ? hardware_concurrency * 4 : 64; // 大量线程
+    const int increments_per_thread = 1000;
+
+    std::string test_name = "极限压力测试(线程数:" + std::to_string(num_threads) + ")";
+    std::cout << "=== " << test_name << " [" << Counter::name() << "] ===" << std::endl;
+    std::cout << "硬件并发数: " << hardware_concurrency << std::endl;
+    std::cout << "测试线程数: " << num_threads << " (约" << (hardware_concurrency > 0 ? hardware_concurrency * 4 : 64) << "倍)" << std::endl;
+    std::cout << "每个线程递增次数: " << increments_per_thread << std::endl;
+
+    std::vector<LatencyHistogram> increment_latency(num_threads);
+    timer_overhead_ns();
+
+    RunTiming timing = WorkerPool::instance().run(num_threads, [&counter, &increment_latency, increments_per_thread](int i) {
+        LatencyHistogram& histogram = increment_latency[i];
+        for (int j = 0; j < increments_per_thread; ++j) {
+            sampled_operation(histogram, j, [&counter]() { return counter.increment(); });
+        }
+    });
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::nanoseconds(timing.duration_ns()));
+
+    int final_count = settled_value(counter);
+    int expected_count = num_threads * increments_per_thread;
+    bool test_passed = (final_count == expected_count);
+    double throughput = ops_per_second(static_cast<size_t>(expected_count), timing);
+
+    std::cout << "实际计数: " << final_count << std::endl;
+    std::cout << "预期计数: " << expected_count << std::endl;
+    std::cout << "耗时: " << duration.count() << " ms" << std::endl;
+    std::cout << "吞吐量: " << std::fixed << std::setprecision(2) << throughput << " 操作/秒" << std::endl;
+    print_run_timing(timing, static_cast<size_t>(expected_count));
+    LatencySummary latency = print_latency("increment()", increment_latency);
+    print_backend_details(counter);
+    std::cout << (test_passed ? "✅ 极限测试通过" : "❌ 极限测试失败") << "\n" << std::endl;
+
+    StressTestResult result = {test_name, duration.count(), expected_count, final_count, test_passed,
+                               static_cast<size_t>(expected_count), throughput, Counter::name()};
+    result.increment_latency = latency;
+    result.timing = timing;
+    return result;
+}
+
+/**
+ * 公平性测试：与极限测试相同的超订线程数，固定时长内统计每个线程获得锁（完成递增）的次数
+ */
+template <typename Counter>
+StressTestResult fairness_test(Counter& counter, int duration_ms) {
+    const unsigned int hardware_concurrency = std::thread::hardware_concurrency();
+    const int num_threads = (hardware_concurrency > 0) ? hardware_concurrency * 4 : 64;
+
+    std::string test_name = "公平性测试(线程数:" + std::to_string(num_threads) + ")";
+    std::cout << "=== " << test_name << " [" << Counter::name() << "] ===" << std::endl;
+    std::cout << "运行时长: " << duration_ms << " ms" << std::endl;
+
+    std::atomic<bool> stop_test{false};
+    std::vector<long> acquisitions(num_threads, 0);
+    std::vector<LatencyHistogram> increment_latency(num_threads);
+    timer_overhead_ns();
+
+    // 线程池在所有线程就位后才同时开闸，先就位的线程不会占优
+    WorkerPool& pool = WorkerPool::instance();
+    pool.launch(num_threads, [&counter, &stop_test, &acquisitions, &increment_latency](int i) {
+        LatencyHistogram& histogram = increment_latency[i];
+        long local = 0;
+        while (!stop_test.load(std::memory_order_relaxed)) {
+            sampled_operation(histogram, local, [&counter]() { return counter.increment(); });
+            ++local;
+        }
+        acquisitions[i] = local;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(duration_ms));
+    stop_test = true;
+    RunTiming timing = pool.wait();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::nanoseconds(timing.duration_ns()));
+
+    double sum = 0.0;
+    double sum_squares = 0.0;
+    long min_acquisitions = acquisitions[0];
+    long max_acquisitions = acquisitions[0];
+    for (long a : acquisitions) {
+        sum += a;
+        sum_squares += static_cast<double>(a) * a;
+        min_acquisitions = std::min(min_acquisitions, a);
+        max_acquisitions = std::max(max_acquisitions, a);
+    }
+    const double mean = sum / num_threads;
+    const double stddev = std::sqrt(std::max(0.0, sum_squares / num_threads - mean * mean));
+    const double jain = (sum_squares > 0) ? (sum * sum) / (num_threads * sum_squares) : 1.0;
+    const double ratio = (min_acquisitions > 0) ? static_cast<double>(max_acquisitions) / min_acquisitions : INFINITY;
+
+    int final_count = settled_value(counter);
+    int expected_count = static_cast<int>(sum);
+    bool test_passed = (final_count == expected_count);
+    double throughput = ops_per_second(static_cast<size_t>(sum), timing);
+
+    std::cout << "每线程获取次数:";
+    for (int i = 0; i < num_threads; ++i) {
+        std::cout << (i % 8 == 0 ? "\n  " : " ") << std::setw(10) << acquisitions[i];
+    }
+    std::cout << std::endl;
+    std::cout << "最少/最多/平均: " << min_acquisitions << " / " << max_acquisitions << " / "
+              << std::fixed << std::setprecision(2) << mean << std::endl;
+    std::cout << "标准差: " << stddev << "，最多/最少: " << ratio << "，Jain 公平性指数: "
+              << std::setprecision(4) << jain << std::endl;
+    std::cout << "实际计数: " << final_count << std::endl;
+    std::cout << "预期计数: " << expected_count << std::endl;
+    std::cout << "吞吐量: " << std::setprecision(2) << throughput << " 操作/秒" << std::endl;
+    print_run_timing(timing, static_cast<size_t>(sum));
+    LatencySummary latency = print_latency("increment()", increment_latency);
+    print_backend_details(counter);
+    std::cout << (test_passed ? "✅ 测试通过" : "❌ 测试失败") << "\n" << std::endl;
+
+    StressTestResult result = {test_name, duration.count(), expected_count, final_count, test_passed,
+                               static_cast<size_t>(sum), throughput, Counter::name()};
+    result.increment_latency = latency;
+    result.fairness_index = jain;
+    result.max_min_ratio = ratio;
+    result.timing = timing;
+    return result;
+}
+
+/**
+ * 性能对比测试：运行不同规模的测试并对比结果
+ */
+template <typename Policy>
+std::vector<StressTestResult> performance_comparison_test() {
+    std::cout << "=== 性能对比测试 [" << Policy::name() << "] ===" << std::endl;
+
+    // 定义不同的测试场景
+    std::vector<std::pair<std::string, std::pair<int, int>>> test_scenarios = {
+        {"轻度负载", {4, 1000}},
+        {"中等负载", {8, 5000}},
+        {"重度负载", {16, 10000}},
+        {"高并发", {32, 2000}},
+        {"大规模操作", {8, 50000}}
+    };
+
+    std::vector<StressTestResult> results;
+
+    // 运行每个测试场景
+    for (const auto& scenario : test_scenarios) {
+        results.push_back(run_trials([&scenario]() {
+            ThreadSafeCounter<Policy> counter; // 每个测试使用新的计数器实例
+            return basic_stress_test(counter, scenario.second.first, scenario.second.second, scenario.first);
+        }));
+    }
+
+    std::cout << std::string(80, '=') << std::endl;
+    std::cout << std::setw(20) << "测试场景"
+              << std::setw(12) << "线程数"
+              << std::setw(12) << "操作数"
+              << std::setw(10) << "耗时(ms)"
+              << std::setw(15) << "吞吐量(ops/s)"
+              << std::setw(10) << "状态" << std::endl;
+    std::cout << std::string(80, '=') << std::endl;
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const StressTestResult& result = results[i];
+        std::cout << std::setw(20) << result.test_name
+                  << std::setw(12) << test_scenarios[i].second.first
+                  << std::setw(12) << test_scenarios[i].second.second
+                  << std::setw(10) << result.duration_ms
+                  << std::setw(15) << std::fixed << std::setprecision(2) << result.throughput_ops_per_sec
+                  << std::setw(10) << (result.passed ? "PASS" : "FAIL") << std::endl;
+    }
+
+    std::cout << std::string(80, '=') << std::endl;
+
+    // 计算平均吞吐量
+    double total_throughput = 0;
+    int passed_tests = 0;
+    for (const auto& result : results) {
+        if (result.passed) {
+            total_throughput += result.throughput_ops_per_sec;
+            passed_tests++;
+        }
+    }
+
+    std::cout << "平均吞吐量: " << (passed_tests > 0 ? total_throughput / passed_tests : 0)
+              << " 操作/秒 (基于" << passed_tests << "个通过测试)" << std::endl;
+    std::cout << "总测试数: " << results.size() << "，通过: " << passed_tests
+              << "，失败: " << (results.size() - passed_tests) << "\n" << std::endl;
+
+    return results;
+}
+
+/**
+ * 扩展性测试：每线程固定工作量，线程数从 1 倍增到 4 倍硬件并发数
+ */
+template <typename Policy>
+std::vector<StressTestResult> thread_scaling_test(int increments_per_thread) {
+    const unsigned int hardware_concurrency = std::thread::hardware_concurrency();
+    const int max_threads = (hardware_concurrency > 0) ? hardware_concurrency * 4 : 64;
+
+    std::vector<StressTestResult> results;
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        results.push_back(run_trials([threads, increments_per_thread]() {
+            ThreadSafeCounter<Policy> counter;
+            return basic_stress_test(counter, threads, increments_per_thread, "扩展性(线程数:" + std::to_string(threads) + ")");
+        }));
+    }
+    return results;
+}
+
+/**
+ * 唯一序号测试：把 increment() 的返回值当作序号，检查所有返回值互不相同，
+ * 并且静止后恰好覆盖 1..N
+ */
+template <typename Counter>
+StressTestResult unique_sequence_test(Counter& counter, int num_threads, int increments_per_thread) {
+    static_assert(!std::is_void<decltype(counter.increment())>::value,
+                  "唯一序号测试需要 increment() 返回序号，分段/每 CPU 计数器不提供");
+    std::string test_name = "唯一序号(线程数:" + std::to_string(num_threads) + ")";
+    std::cout << "=== " << test_name << " [" << Counter::name() << "] ===" << std::endl;
+
+    std::vector<std::vector<int>> returned(num_threads);
+    for (auto& values : returned) {
+        values.reserve(increments_per_thread);
+    }
+
+    RunTiming timing = WorkerPool::instance().run(num_threads, [&counter, &returned, increments_per_thread](int i) {
+        std::vector<int>& values = returned[i];
+        for (int j = 0; j < increments_per_thread; ++j) {
+            values.push_back(counter.increment());
+        }
+    });
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::nanoseconds(timing.duration_ns()));
+
+    std::vector<int> all_values;
+    all_values.reserve(static_cast<size_t>(num_threads) * increments_per_thread);
+    for (const auto& values : returned) {
+        all_values.insert(all_values.end(), values.begin(), values.end());
+    }
+    std::sort(all_values.begin(), all_values.end());
+    size_t duplicates = 0;
+    size_t out_of_range = 0;
+    for (size_t i = 0; i < all_values.size(); ++i) {
+        if (i > 0 && all_values[i] == all_values[i - 1]) {
+            ++duplicates;
+        }
+        if (all_values[i] < 1 || all_values[i] > static_cast<int>(all_values.size())) {
+            ++out_of_range;
+        }
+    }
+
+    int final_count = counter.get();
+    int expected_count = num_threads * increments_per_thread;
+    bool test_passed = (final_count == expected_count) && duplicates == 0 && out_of_range == 0;
+    size_t total_ops = static_cast<size_t>(expected_count);
+    double throughput = ops_per_second(total_ops, timing);
+
+    std::cout << "重复序号: " << duplicates << "，超出 1..N 的序号: " << out_of_range << std::endl;
+    std::cout << "实际计数: " << final_count << std::endl;
+    std::cout << "预期计数: " << expected_count << std::endl;
+    std::cout << "耗时: " << duration.count() << " ms" << std::endl;
+    std::cout << "吞吐量: " << std::fixed << std::setprecision(2) << throughput << " 操作/秒" << std::endl;
+    print_run_timing(timing, total_ops);
+    std::cout << (test_passed ? "✅ 测试通过" : "❌ 测试失败") << "\n" << std::endl;
+
+    StressTestResult result = {test_name, duration.count(), expected_count, final_count, test_passed, total_ops, throughput, Counter::name()};
+    result.timing = timing;
+    return result;
+}
+
+/**
+ * ID 分配器测试：仿照基础压力测试，多线程领取 ID，校验唯一性并测量吞吐量
+ *
+ * 所有线程退出后，已预留但未发放的 ID 应全部回到回收池。
+ * slow_ids > 0 时奇数号线程在快速领取之后再以 think_us 的间隔慢速领取
+ * slow_ids 个，用来观察空闲线程的块大小回落。
+ */
+template <typename Allocator>
+StressTestResult id_allocator_test(Allocator& allocator, int num_threads, int ids_per_thread, int slow_ids = 0, int think_us = 100) {
+    std::string test_name = "ID分配(线程数:" + std::to_string(num_threads) + (slow_ids > 0 ? ",含慢线程)" : ")");
+    std::cout << "=== " << test_name << " [" << Allocator::name() << "] ===" << std::endl;
+    std::cout << "配置: " << num_threads << " 线程 × " << ids_per_thread << " 个 ID";
+    if (slow_ids > 0) {
+        std::cout << "，奇数号线程再每隔 " << think_us << " us 领取 " << slow_ids << " 个";
+    }
+    std::cout << std::endl;
+
+    std::vector<std::vector<int>> issued(num_threads);
+    std::vector<int> final_blocks(num_threads, 0);
+    std::vector<long> refills(num_threads, 0);
+
+    // 依赖线程退出时把余量归还回收池，不能用常驻线程池
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_threads; ++i) {
+        threads.emplace_back(pinned(i, [&allocator, &issued, &final_blocks, &refills, ids_per_thread, slow_ids, think_us, i]() {
+            const bool slow = (slow_ids > 0) && (i % 2 == 1);
+            std::vector<int>& ids = issued[i];
+            ids.reserve(ids_per_thread + (slow ? slow_ids : 0));
+            for (int j = 0; j < ids_per_thread; ++j) {
+                ids.push_back(allocator.next());
+            }
+            if (slow) {
+                for (int j = 0; j < slow_ids; ++j) {
+                    std::this_thread::sleep_for(std::chrono::microseconds(think_us));
+                    ids.push_back(allocator.next());
+                }
+            }
+            final_blocks[i] = allocator.block_size();
+            refills[i] = allocator.thread_refills();
+        }));
+    }
+
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+    // 块内发放极快，按纳秒计算吞吐量，避免毫秒取整为 0
+    auto duration_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time);
+
+    std::vector<int> all_ids;
+    long total_refills = 0;
+    for (int i = 0; i < num_threads; ++i) {
+        all_ids.insert(all_ids.end(), issued[i].begin(), issued[i].end());
+        total_refills += refills[i];
+    }
+    std::sort(all_ids.begin(), all_ids.end());
+    const int reserved = allocator.reserved();
+    size_t duplicates = 0;
+    size_t out_of_range = 0;
+    for (size_t i = 0; i < all_ids.size(); ++i) {
+        if (i > 0 && all_ids[i] == all_ids[i - 1]) {
+            ++duplicates;
+        }
+        if (all_ids[i] < 1 || all_ids[i] > reserved) {
+            ++out_of_range;
+        }
+    }
+
+    // 所有线程已退出，预留而未发放的 ID 只能在回收池里
+    const long unissued = reserved - static_cast<long>(all_ids.size());
+    const long pooled = allocator.pooled();
+    int expected_count = static_cast<int>(all_ids.size());
+    int distinct_count = static_cast<int>(all_ids.size() - duplicates);
+    bool test_passed = duplicates == 0 && out_of_range == 0 && unissued == pooled;
+    size_t total_ops = all_ids.size();
+    double throughput = (duration_ns.count() > 0) ? (total_ops * 1e9) / duration_ns.count() : 0.0;
+
+    std::cout << "重复 ID: " << duplicates << "，超出 1..已预留 的 ID: " << out_of_range << std::endl;
+    std::cout << "已发放: " << all_ids.size() << "，已预留: " << reserved << "，回收池: " << pooled
+              << "，未发放: " << unissued << std::endl;
+    std::cout << "共享计数器操作: " << total_refills << " 次 (平均每次 "
+              << std::fixed << std::setprecision(1) << (total_refills > 0 ? static_cast<double>(total_ops) / total_refills : 0.0)
+              << " 个 ID)" << std::endl;
+    std::cout << "线程最终块大小:";
+    for (int i = 0; i < num_threads; ++i) {
+        std::cout << (i % 8 == 0 ? "\n  " : " ") << std::setw(6) << final_blocks[i];
+    }
+    std::cout << std::endl;
+    std::cout << "耗时: " << duration.count() << " ms" << std::endl;
+    std::cout << "吞吐量: " << std::setprecision(2) << throughput << " 操作/秒" << std::endl;
+    std::cout << (test_passed ? "✅ 测试通过" : "❌ 测试失败") << "\n" << std::endl;
+
+    return {test_name, duration.count(), expected_count, distinct_count, test_passed, total_ops, throughput, Allocator::name()};
+}
+
+/// CAS 退避测试中每次调用失败次数的分桶上界：0, 1, 2-3, 4-7, 8-15, 16-63, 64+
+const unsigned CAS_RETRY_BUCKETS[] = {0, 1, 3, 7, 15, 63};
+constexpr size_t CAS_RETRY_BUCKET_COUNT = sizeof(CAS_RETRY_BUCKETS) / sizeof(CAS_RETRY_BUCKETS[0]) + 1;
+
+/**
+ * CAS 退避测试：多线程对同一个原子变量做 atomic_update(+1)，
+ * 统计每次调用的 CAS 失败次数分布、总失败率和吞吐量
+ */
+template <typename Backoff>
+StressTestResult cas_backoff_test(int num_threads, int updates_per_thread) {
+    std::string test_name = "CAS退避(线程数:" + std::to_string(num_threads) + ")";
+    std::cout << "=== " << test_name << " [" << Backoff::name() << "] ===" << std::endl;
+
+    std::atomic<int> target{0};
+    std::vector<std::vector<unsigned long>> histograms(num_threads, std::vector<unsigned long>(CAS_RETRY_BUCKET_COUNT, 0));
+    std::vector<unsigned long> total_retries(num_threads, 0);
+
+    RunTiming timing = WorkerPool::instance().run(num_threads, [&target, &histograms, &total_retries, updates_per_thread](int i) {
+        std::vector<unsigned long> histogram(CAS_RETRY_BUCKET_COUNT, 0);
+        unsigned long retries_sum = 0;
+        for (int j = 0; j < updates_per_thread; ++j) {
+            unsigned retries = 0;
+            atomic_update(target, [](int value) { return value + 1; }, Backoff(), &retries);
+            size_t bucket = 0;
+            while (bucket < CAS_RETRY_BUCKET_COUNT - 1 && retries > CAS_RETRY_BUCKETS[bucket]) {
+                ++bucket;
+            }
+            ++histogram[bucket];
+            retries_sum += retries;
+        }
+        histograms[i] = histogram;
+        total_retries[i] = retries_sum;
+    });
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::nanoseconds(timing.duration_ns()));
+
+    std::vector<unsigned long> histogram(CAS_RETRY_BUCKET_COUNT, 0);
+    unsigned long retries = 0;
+    for (int i = 0; i < num_threads; ++i) {
+        for (size_t b = 0; b < CAS_RETRY_BUCKET_COUNT; ++b) {
+            histogram[b] += histograms[i][b];
+        }
+        retries += total_retries[i];
+    }
+
+    int final_count = target.load();
+    int expected_count = num_threads * updates_per_thread;
+    bool test_passed = (final_count == expected_count);
+    size_t total_ops = static_cast<size_t>(expected_count);
+    double throughput = ops_per_second(total_ops, timing);
+    double failure_rate = static_cast<double>(retries) / (retries + total_ops);
+
+    std::cout << "每次调用的失败次数分布:" << std::endl;
+    unsigned lower = 0;
+    for (size_t b = 0; b < CAS_RETRY_BUCKET_COUNT; ++b) {
+        std::string label = (b == CAS_RETRY_BUCKET_COUNT - 1) ? std::to_string(lower) + "+"
+                          : (lower == CAS_RETRY_BUCKETS[b]) ? std::to_string(lower)
+                          : std::to_string(lower) + "-" + std::to_string(CAS_RETRY_BUCKETS[b]);
+        std::cout << "  " << std::setw(8) << label << ": " << std::setw(10) << histogram[b]
+                  << " (" << std::fixed << std::setprecision(2) << 100.0 * histogram[b] / total_ops << "%)" << std::endl;
+        if (b < CAS_RETRY_BUCKET_COUNT - 1) {
+            lower = CAS_RETRY_BUCKETS[b] + 1;
+        }
+    }
+    std::cout << "CAS 失败次数: " << retries << "，失败率: " << std::setprecision(2) << 100.0 * failure_rate << "%" << std::endl;
+    std::cout << "实际计数: " << final_count << std::endl;
+    std::cout << "预期计数: " << expected_count << std::endl;
+    std::cout << "耗时: " << duration.count() << " ms" << std::endl;
+    std::cout << "吞吐量: " << throughput << " 操作/秒" << std::endl;
+    print_run_timing(timing, total_ops);
+    std::cout << (test_passed ? "✅ 测试通过" : "❌ 测试失败") << "\n" << std::endl;
+
+    StressTestResult result = {test_name, duration.count(), expected_count, final_count, test_passed,
+                               total_ops, throughput, Backoff::name()};
+    result.cas_failure_rate = failure_rate;
+    result.timing = timing;
+    return result;
+}
+
+/**
+ * 当前进程的常驻内存 (RSS)，单位字节；读取失败返回 0
+ */
+inline size_t resident_bytes() {
+    std::ifstream statm("/proc/self/statm");
+    size_t total_pages = 0;
+    size_t resident_pages = 0;
+    if (!(statm >> total_pages >> resident_pages)) {
+        return 0;
+    }
+    return resident_pages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
+
+/**
+ * 计数器数组测试：分配大量计数器，测量内存占用，并发随机递增测吞吐量
+ */
+template <typename Policy>
+StressTestResult counter_array_test(size_t num_counters, int num_threads, int increments_per_thread) {
+    typedef ThreadSafeCounter<Policy> Counter;
+    std::string test_name = "计数器数组(" + std::to_string(num_counters / 1000000) + "M)";
+    std::cout << "=== " << test_name << " [" << Counter::name() << "] ===" << std::endl;
+
+    size_t rss_before = resident_bytes();
+    std::unique_ptr<Counter[]> counters(new Counter[num_counters]);
+    size_t rss_after = resident_bytes();
+    size_t footprint = sizeof(Counter) * num_counters;
+
+    std::cout << "sizeof(计数器): " << sizeof(Counter) << " 字节" << std::endl;
+    std::cout << "数组大小: " << std::fixed << std::setprecision(1) << footprint / (1024.0 * 1024.0) << " MB"
+              << "，RSS 增长: " << (rss_after > rss_before ? rss_after - rss_before : 0) / (1024.0 * 1024.0) << " MB" << std::endl;
+
+    RunTiming timing = WorkerPool::instance().run(num_threads, [&counters, num_counters, increments_per_thread](int i) {
+        // xorshift 伪随机选择计数器，各线程种子不同
+        unsigned long long state = 0x9E3779B97F4A7C15ull * (i + 1);
+        for (int j = 0; j < increments_per_thread; ++j) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            counters[state % num_counters].increment();
+        }
+    });
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::nanoseconds(timing.duration_ns()));
+
+    long long total = 0;
+    for (size_t i = 0; i < num_counters; ++i) {
+        total += counters[i].get();
+    }
+    int expected_count = num_threads * increments_per_thread;
+    bool test_passed = (total == expected_count);
+    size_t total_ops = static_cast<size_t>(expected_count);
+    double throughput = ops_per_second(total_ops, timing);
+
+    std::cout << "所有计数器之和: " << total << std::endl;
+    std::cout << "预期计数: " << expected_count << std::endl;
+    std::cout << "耗时: " << duration.count() << " ms" << std::endl;
+    std::cout << "吞吐量: " << std::setprecision(2) << throughput << " 操作/秒" << std::endl;
+    print_run_timing(timing, total_ops);
+    std::cout << (test_passed ? "✅ 测试通过" : "❌ 测试失败") << "\n" << std::endl;
+
+    StressTestResult result = {test_name, duration.count(), expected_count, static_cast<int>(total), test_passed,
+                               total_ops, throughput, Counter::name()};
+    result.memory_bytes = footprint;
+    result.timing = timing;
+    return result;
+}
+
+/**
+ * get() 相对已完成递增数允许落后的上限；精确计数器为 0，需要的后端提供重载
+ */
+template <typename Counter>
+long read_error_bound(const Counter&, int) { return 0; }
+
+template <unsigned Threshold>
+long read_error_bound(const ThreadSafeCounter<SloppyPolicy<Threshold>>& counter, int threads) {
+    return counter.error_bound(threads);
+}
+
+/**
+ * 已完成递增数与 int 计数器读数之差，按 32 位回绕计算
+ *
+ * 快速后端 10 秒内的递增数会超过 INT_MAX，计数器随之回绕；
+ * 只要真实差值远小于 2^31，按 unsigned 相减仍能得到正确结果。
+ */
+inline long wrapped_difference(long completed, int value) {
+    return static_cast<int>(static_cast<unsigned>(completed) - static_cast<unsigned>(value));
+}
+
+/**
+ * 长时间稳定性测试
+ *
+ * 读线程每次先汇总各工作线程已完成的递增数，再调用 get()，
+ * 两者之差即这次读取的误差（get() 落后于已完成递增的量），记录最大值。
+ */
+template <typename Policy>
+StressTestResult long_running_stability_test(int duration_seconds = 10) {
+    std::string test_name = "长时间稳定性测试";
+    std::cout << "=== " << test_name << " (运行" << duration_seconds << "秒) [" << Policy::name() << "] ===" << std::endl;
+
+    // 每个工作线程的完成次数各占一个缓存行，避免统计本身成为争用点
+    struct alignas(CACHE_LINE_SIZE) DoneCount {
+        std::atomic<long> value{0};
+    };
+
+    ThreadSafeCounter<Policy> counter;
+    std::atomic<bool> stop_test{false};
+    std::atomic<int> reads_done{0};
+    std::atomic<long> max_read_error{0};
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    // 创建多个工作线程
+    std::vector<std::thread> workers;
+    const int num_workers = 8;
+    std::unique_ptr<DoneCount[]> increments_done(new DoneCount[num_workers]);
+    std::vector<LatencyHistogram> increment_latency(num_workers);
+    std::vector<LatencyHistogram> get_latency(1);
+    timer_overhead_ns();
+
+    for (int i = 0; i < num_workers; ++i) {
+        workers.emplace_back(pinned(i, [&counter, &stop_test, &increments_done, &increment_latency, i]() {
+            std::atomic<long>& done = increments_done[i].value;
+            LatencyHistogram& histogram = increment_latency[i];
+            while (!stop_test) {
+                sampled_operation(histogram, done.load(std::memory_order_relaxed), [&counter]() { return counter.increment(); });
+                done.store(done.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+                // 偶尔休息一下
+                if (i % 2 == 0) {
+                    std::this_thread::sleep_for(std::chrono::microseconds(10));
+                }
+            }
+        }));
+    }
+
+    // 创建读线程
+    std::thread reader(pinned(num_workers, [&counter, &stop_test, &reads_done, &increments_done, &max_read_error, &get_latency, num_workers]() {
+        LatencyHistogram& histogram = get_latency[0];
+        long max_error = 0;
+        while (!stop_test) {
+            long completed = 0;
+            for (int i = 0; i < num_workers; ++i) {
+                completed += increments_done[i].value.load(std::memory_order_acquire);
+            }
+            int val = sampled_operation(histogram, reads_done.load(std::memory_order_relaxed), [&counter]() { return counter.get(); });
+            reads_done++;
+            // 读取的值应该非负（计数未超过 int 范围时）
+            if (val < 0 && completed <= std::numeric_limits<int>::max()) {
+                std::cerr << "错误: 计数器值为负!" << std::endl;
+            }
+            max_error = std::max(max_error, wrapped_difference(completed, val));
+            std::this_thread::sleep_for(std::chrono::microseconds(5));
+        }
+        max_read_error = max_error;
+    }));
+
+    std::this_thread::sleep_for(std::chrono::seconds(duration_seconds));
+    stop_test = true;
+
+    // 等待所有线程结束
+    for (auto& t : workers) {
+        t.join();
+    }
+    reader.join();
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+
+    long total_increments = 0;
+    for (int i = 0; i < num_workers; ++i) {
+        total_increments += increments_done[i].value.load();
+    }
+    int final_count = counter.get();
+    const long long elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count();
+    double throughput = (elapsed_ns > 0) ? (total_increments * 1e9 / elapsed_ns) : 0.0;
+    const long error_bound = read_error_bound(counter, num_workers);
+
+    std::cout << "测试时长: " << duration.count() << " ms" << std::endl;
+    std::cout << "最终计数值: " << final_count << std::endl;
+    std::cout << "总递增次数: " << total_increments << std::endl;
+    std::cout << "总读取次数: " << reads_done.load() << std::endl;
+    std::cout << "吞吐量: " << throughput << " 递增操作/秒" << std::endl;
+    std::cout << "读取最大误差: " << max_read_error.load() << " (上限 " << error_bound << ")" << std::endl;
+    LatencySummary increment_summary = print_latency("increment()", increment_latency);
+    LatencySummary get_summary = print_latency("get()", get_latency);
+
+    // 验证：最终计数应与总递增次数一致，运行中的读取误差不超过后端声明的上限
+    bool consistent = wrapped_difference(total_increments, final_count) == 0 && max_read_error <= error_bound;
+    std::cout << "数据一致性: " << (consistent ? "✅ 一致" : "❌ 不一致") << "\n" << std::endl;
+
+    StressTestResult result = {test_name, duration.count(), static_cast<int>(total_increments), final_count, consistent,
+                               static_cast<size_t>(total_increments + reads_done.load()), throughput, Policy::name()};
+    result.max_read_error = max_read_error.load();
+    result.increment_latency = increment_summary;
+    result.get_latency = get_summary;
+    return result;
+}
+
+/// 按比例混合读写测试中读操作所占的百分比
+const int MIXED_READ_PERCENTS[] = {99, 90, 50};
+
+/**
+ * 命令行描述的负载：每个线程按 read_percent% 的概率读、否则递增，
+ * 两次操作之间忙等 think_ns 纳秒；固定操作数或固定时长二选一
+ */
+struct Workload {
+    long ops_per_thread = 100000;   ///< duration_ms 为 0 时每个线程的操作数
+    int duration_ms = 0;            ///< 大于 0 时按时长运行，忽略 ops_per_thread
+    int read_percent = 0;
+    long think_ns = 0;
+};
+
+/**
+ * 忙等 ns 纳秒，模拟两次计数器操作之间的业务处理；不让出 CPU，亚微秒级也准确
+ */
+inline void think_for(long ns) {
+    if (ns <= 0) {
+        return;
+    }
+    const auto until = std::chrono::steady_clock::now() + std::chrono::nanoseconds(ns);
+    while (std::chrono::steady_clock::now() < until) {
+    }
+}
+
+/**
+ * 按 Workload 运行一次：线程数、读写比例、思考时间与操作数/时长都来自命令行
+ */
+template <typename Counter>
+StressTestResult workload_test(Counter& counter, int num_threads, const Workload& workload, int repetition) {
+    std::ostringstream name;
+    name << "负载(线程:" << num_threads << ",读:" << workload.read_percent << "%";
+    if (workload.think_ns > 0) {
+        name << ",思考:" << workload.think_ns << "ns";
+    }
+    name << ")#" << repetition;
+    const std::string test_name = name.str();
+    std::cout << "=== " << test_name << " [" << Counter::name() << "] ===" << std::endl;
+    std::cout << "配置: " << num_threads << " 线程 × ";
+    if (workload.duration_ms > 0) {
+        std::cout << workload.duration_ms << " ms";
+    } else {
+        std::cout << workload.ops_per_thread << " 次操作";
+    }
+    std::cout << "，读比例 " << workload.read_percent << "%，思考时间 " << workload.think_ns << " ns" << std::endl;
+
+    std::atomic<bool> stop_test{false};
+    std::atomic<long> total_reads{0};
+    std::atomic<long> total_writes{0};
+    std::atomic<int> read_errors{0};
+    int initial_count = counter.get();
+    std::vector<LatencyHistogram> increment_latency(num_threads);
+    std::vector<LatencyHistogram> get_latency(num_threads);
+    timer_overhead_ns();
+
+    const long ops_limit = workload.duration_ms > 0 ? std::numeric_limits<long>::max() : workload.ops_per_thread;
+    WorkerPool& pool = WorkerPool::instance();
+    pool.launch(num_threads, [&counter, &stop_test, &total_reads, &total_writes, &read_errors, &increment_latency,
+                              &get_latency, &workload, ops_limit](int i) {
+        LatencyHistogram& increment_histogram = increment_latency[i];
+        LatencyHistogram& get_histogram = get_latency[i];
+        unsigned long long state = 0x9E3779B97F4A7C15ull * (i + 1);
+        long reads = 0;
+        long writes = 0;
+        for (long j = 0; j < ops_limit && !stop_test.load(std::memory_order_relaxed); ++j) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            if (static_cast<int>(state % 100) < workload.read_percent) {
+                if (sampled_operation(get_histogram, reads, [&counter]() { return counter.get(); }) < 0) {
+                    read_errors++;
+                }
+                ++reads;
+            } else {
+                sampled_operation(increment_histogram, writes, [&counter]() { return counter.increment(); });
+                ++writes;
+            }
+            think_for(workload.think_ns);
+        }
+        total_reads += reads;
+        total_writes += writes;
+    });
+    if (workload.duration_ms > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(workload.duration_ms));
+        stop_test = true;
+    }
+    RunTiming timing = pool.wait();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::nanoseconds(timing.duration_ns()));
+
+    int final_count = settled_value(counter);
+    // 按时长运行时快速后端的递增数可能超过 INT_MAX，按 32 位回绕比较；回绕后读到负值是正常的
+    const long completed = initial_count + total_writes.load();
+    int expected_final_count = static_cast<int>(static_cast<unsigned>(completed));
+    bool test_passed = wrapped_difference(completed, final_count) == 0 && (read_errors == 0 || completed > INT_MAX);
+    size_t total_ops = static_cast<size_t>(total_reads + total_writes);
+    double throughput = ops_per_second(total_ops, timing);
+
+    std::cout << "读取次数: " << total_reads << "，写入次数: " << total_writes << std::endl;
+    std::cout << "实际最终计数: " << final_count << std::endl;
+    std::cout << "预期最终计数: " << expected_final_count << std::endl;
+    std::cout << "耗时: " << duration.count() << " ms" << std::endl;
+    std::cout << "吞吐量: " << std::fixed << std::setprecision(2) << throughput << " 操作/秒" << std::endl;
+    print_run_timing(timing, total_ops);
+    LatencySummary increment_summary = print_latency("increment()", increment_latency);
+    LatencySummary get_summary = print_latency("get()", get_latency);
+    print_backend_details(counter);
+    std::cout << (test_passed ? "✅ 测试通过" : "❌ 测试失败") << "\n" << std::endl;
+
+    StressTestResult result = {test_name, duration.count(), expected_final_count, final_count, test_passed, total_ops, throughput, Counter::name()};
+    result.increment_latency = increment_summary;
+    result.get_latency = get_summary;
+    result.timing = timing;
+    return result;
+}
+
+/**
+ * 对单个后端运行全部场景，结果追加到 summary
+ */
+template <typename Policy>
+void run_all_scenarios(std::vector<StressTestResult>& summary) {
+    std::cout << std::string(50, '#') << std::endl;
+    std::cout << "后端: " << Policy::name() << std::endl;
+    std::cout << std::string(50, '#') << std::endl;
+
+    // 每个场景经由 run_trials 运行，每次试验构造新的计数器
+
+    // 1. 基础压力测试
+    summary.push_back(run_trials([]() {
+        ThreadSafeCounter<Policy> counter;
+        return basic_stress_test(counter, 10, 10000, "基础压力测试");
+    }));
+    print_lock_profile();
+
+    // 2. 混合读写压力测试
+    summary.push_back(run_trials([]() {
+        ThreadSafeCounter<Policy> counter;
+        return mixed_read_write_stress_test(counter, 5, 2000, 3, 5000);
+    }));
+    print_lock_profile();
+
+    // 按读写比例混合，观察读多写少时读锁能否并行
+    for (int read_percent : MIXED_READ_PERCENTS) {
+        summary.push_back(run_trials([read_percent]() {
+            ThreadSafeCounter<Policy> counter;
+            return mixed_ratio_stress_test(counter, 8, 100000, read_percent);
+        }));
+        print_lock_profile();
+    }
+
+    // 3. 极限压力测试
+    summary.push_back(run_trials([]() {
+        ThreadSafeCounter<Policy> counter;
+        return extreme_stress_test(counter);
+    }));
+    print_lock_profile();
+
+    // 4. 公平性测试
+    summary.push_back(run_trials([]() {
+        ThreadSafeCounter<Policy> counter;
+        return fairness_test(counter, 500);
+    }));
+    print_lock_profile();
+
+    // 5. 性能对比测试
+    std::vector<StressTestResult> comparison = performance_comparison_test<Policy>();
+    summary.insert(summary.end(), comparison.begin(), comparison.end());
+    print_lock_profile();
+
+    // 6. 扩展性测试
+    std::vector<StressTestResult> scaling = thread_scaling_test<Policy>(20000);
+    summary.insert(summary.end(), scaling.begin(), scaling.end());
+    print_lock_profile();
+
+    // 7. 长时间稳定性测试：按时长检验稳定性，不做重复试验
+    summary.push_back(long_running_stability_test<Policy>());
+    print_lock_profile();
+}
+
+/// 计数器数组测试中的计数器个数
+constexpr size_t COUNTER_ARRAY_SIZE = 10000000;
+
+// 参与对比的后端列表，新增后端只需加到 AllBackends 中
+template <typename... Policies>
+struct BackendList {};
+
+typedef BackendList<MutexPolicy, FutexMutexPolicy, SpinLockPolicy, AtomicPolicy, StripedPolicy, PerCpuPolicy,
+                    TicketLockPolicy, McsLockPolicy, CohortLockPolicy, ParkingLotPolicy, PhaseFairRwLockPolicy,
+                    FlatCombiningPolicy, CountingNetworkPolicy<8>, SloppyPolicy<64>> AllBackends;
+
+// 单个计数器体积小、适合放进大数组的后端，参与计数器数组测试
+typedef BackendList<MutexPolicy, FutexMutexPolicy, SpinLockPolicy, ParkingLotPolicy, AtomicPolicy> CompactBackends;
+
+// 唯一序号测试：不同宽度的计数网络，以 atomic/mutex 作为对照
+typedef BackendList<CountingNetworkPolicy<2>, CountingNetworkPolicy<4>, CountingNetworkPolicy<8>,
+                    CountingNetworkPolicy<16>, AtomicPolicy, MutexPolicy> SequenceBackends;
+
+// 粗略计数器：不同刷新阈值下的吞吐量与读取误差，以 atomic 作为对照
+typedef BackendList<SloppyPolicy<1>, SloppyPolicy<16>, SloppyPolicy<256>, SloppyPolicy<4096>, AtomicPolicy> SloppyBackends;
+
+// ID 分配器：按块预留所依托的计数器后端
+typedef BackendList<AtomicPolicy, MutexPolicy, FutexMutexPolicy> IdAllocatorBackends;
+
+// CAS 退避策略，按同样的方式逐个运行 CAS 退避测试
+typedef BackendList<NoBackoff, PauseBackoff, ExponentialBackoff<>, RandomizedExponentialBackoff<>,
+                    YieldAfterBackoff<>> BackoffPolicies;
+
+template <typename Policy>
+struct BackendTag {
+    typedef Policy type;
+};
+
+/**
+ * 对列表中每个后端调用 f(BackendTag<Policy>())
+ */
+template <typename Function>
+void for_each_backend(BackendList<>, Function&&) {}
+
+template <typename Policy, typename... Rest, typename Function>
+void for_each_backend(BackendList<Policy, Rest...>, Function&& f) {
+    f(BackendTag<Policy>());
+    for_each_backend(BackendList<Rest...>(), f);
+}
+
+/**
+ * 内存占用汇总：计数器数组测试中每个后端的单个计数器大小、数组总大小和吞吐量
+ */
+void print_memory_summary(const std::vector<StressTestResult>& summary) {
+    std::cout << "=== 内存占用汇总 ===" << std::endl;
+    std::cout << std::string(66, '=') << std::endl;
+    std::cout << std::setw(18) << "后端" << std::setw(16) << "每计数器(B)" << std::setw(16) << "总计(MB)"
+              << std::setw(16) << "吞吐量(ops/s)" << std::endl;
+    std::cout << std::string(66, '=') << std::endl;
+    for (const auto& result : summary) {
+        if (result.memory_bytes > 0) {
+            std::cout << std::setw(18) << result.backend
+                      << std::setw(16) << result.memory_bytes / COUNTER_ARRAY_SIZE
+                      << std::setw(16) << std::fixed << std::setprecision(1) << result.memory_bytes / (1024.0 * 1024.0)
+                      << std::setw(16) << std::setprecision(0) << result.throughput_ops_per_sec << std::endl;
+        }
+    }
+    std::cout << std::string(66, '=') << "\n" << std::endl;
+}
+
+/**
+ * 并排打印：每行一个场景，每列一个后端，单元格为 value(结果)；value 返回负数的结果显示为 -
+ */
+template <typename Value>
+void print_backend_table(const std::vector<StressTestResult>& summary, const std::string& title, Value value) {
+    std::vector<std::string> scenarios;
+    std::vector<std::string> backends;
+    for (const auto& result : summary) {
+        if (std::find(scenarios.begin(), scenarios.end(), result.test_name) == scenarios.end()) {
+            scenarios.push_back(result.test_name);
+        }
+        if (std::find(backends.begin(), backends.end(), result.backend) == backends.end()) {
+            backends.push_back(result.backend);
+        }
+    }
+
+    const size_t width = 28 + backends.size() * 18;
+    std::cout << "=== " << title << " ===" << std::endl;
+    std::cout << std::string(width, '=') << std::endl;
+    std::cout << std::setw(28) << "测试场景";
+    for (const auto& backend : backends) {
+        std::cout << std::setw(18) << backend;
+    }
+    std::cout << std::endl;
+    std::cout << std::string(width, '=') << std::endl;
+
+    for (const auto& scenario : scenarios) {
+        std::cout << std::setw(28) << scenario;
+        for (const auto& backend : backends) {
+            std::string cell = "-";
+            for (const auto& result : summary) {
+                if (result.test_name == scenario && result.backend == backend) {
+                    const double cell_value = value(result);
+                    if (cell_value >= 0) {
+                        std::ostringstream out;
+                        out << std::fixed << std::setprecision(0) << cell_value << (result.passed ? "" : "*");
+                        cell = out.str();
+                    }
+                    break;
+                }
+            }
+            std::cout << std::setw(18) << cell;
+        }
+        std::cout << std::endl;
+    }
+    std::cout << std::string(width, '=') << "\n" << std::endl;
+}
+
+/**
+ * 并排打印各后端的吞吐量(ops/s)
+ */
+void print_side_by_side(const std::vector<StressTestResult>& summary) {
+    print_backend_table(summary, "后端并排对比 (吞吐量 ops/s，* 表示失败)",
+                        [](const StressTestResult& result) { return result.throughput_ops_per_sec; });
+}
+
+/**
+ * 并排打印各后端每 CPU 秒完成的操作数：超订时自旋的后端吞吐量可能不低，
+ * 但烧掉的 CPU 更多；没有 CPU 用量的场景（未经线程池运行）显示为 -
+ */
+void print_cpu_efficiency(const std::vector<StressTestResult>& summary) {
+    print_backend_table(summary, "CPU 效率对比 (每 CPU 秒操作数，* 表示失败)", [](const StressTestResult& result) {
+        const CpuUsage usage = result.timing.usage();
+        return usage.threads > 0 && usage.cpu_ns > 0 ? usage.operations_per_cpu_second(result.total_operations) : -1.0;
+    });
+}
+
+/**
+ * 公平性汇总：每个后端在公平性测试中的 Jain 指数和最多/最少获取次数之比
+ */
+void print_fairness_summary(const std::vector<StressTestResult>& summary) {
+    std::cout << "=== 公平性汇总 (Jain 指数越接近 1 越公平) ===" << std::endl;
+    std::cout << std::string(50, '=') << std::endl;
+    std::cout << std::setw(18) << "后端" << std::setw(16) << "Jain指数" << std::setw(16) << "最多/最少" << std::endl;
+    std::cout << std::string(50, '=') << std::endl;
+    for (const auto& result : summary) {
+        if (result.fairness_index > 0.0) {
+            std::cout << std::setw(18) << result.backend
+                      << std::setw(16) << std::fixed << std::setprecision(4) << result.fairness_index
+                      << std::setw(16) << std::setprecision(2) << result.max_min_ratio << std::endl;
+        }
+    }
+    std::cout << std::string(50, '=') << "\n" << std::endl;
+}
+
+/**
+ * 读取误差汇总：长时间稳定性测试中每个后端的吞吐量与 get() 的最大落后量
+ */
+void print_read_error_summary(const std::vector<StressTestResult>& summary) {
+    std::cout << "=== 读取误差汇总 (get() 落后于已完成递增的最大值) ===" << std::endl;
+    std::cout << std::string(50, '=') << std::endl;
+    std::cout << std::setw(18) << "后端" << std::setw(16) << "吞吐量(ops/s)" << std::setw(16) << "最大误差" << std::endl;
+    std::cout << std::string(50, '=') << std::endl;
+    for (const auto& result : summary) {
+        if (result.max_read_error >= 0) {
+            std::cout << std::setw(18) << result.backend
+                      << std::setw(16) << std::fixed << std::setprecision(0) << result.throughput_ops_per_sec
+                      << std::setw(16) << result.max_read_error << std::endl;
+        }
+    }
+    std::cout << std::string(50, '=') << "\n" << std::endl;
+}
+
+/**
+ * CAS 退避汇总：每个退避策略在各线程数下的吞吐量与 CAS 失败率
+ */
+void print_cas_summary(const std::vector<StressTestResult>& summary) {
+    std::cout << "=== CAS 退避汇总 ===" << std::endl;
+    std::cout << std::string(74, '=') << std::endl;
+    std::cout << std::setw(18) << "退避策略" << std::setw(24) << "测试场景" << std::setw(16) << "吞吐量(ops/s)"
+              << std::setw(16) << "失败率(%)" << std::endl;
+    std::cout << std::string(74, '=') << std::endl;
+    for (const auto& result : summary) {
+        if (result.cas_failure_rate >= 0.0) {
+            std::cout << std::setw(18) << result.backend << std::setw(24) << result.test_name
+                      << std::setw(16) << std::fixed << std::setprecision(0) << result.throughput_ops_per_sec
+                      << std::setw(16) << std::setprecision(2) << 100.0 * result.cas_failure_rate << std::endl;
+        }
+    }
+    std::cout << std::string(74, '=') << "\n" << std::endl;
+}
+
+/**
+ * 中位数；values 为空时为 0
+ */
+inline double median_of(std::vector<double> values) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    const size_t middle = values.size() / 2;
+    std::nth_element(values.begin(), values.begin() + middle, values.end());
+    const double upper = values[middle];
+    if (values.size() % 2 == 1) {
+        return upper;
+    }
+    return (upper + *std::max_element(values.begin(), values.begin() + middle)) / 2.0;
+}
+
+/**
+ * 扩展性分析：include(结果) 为真的结果按后端分组，以线程数为横轴（同一线程数多次运行取中位数）
+ * 拟合 Amdahl 与 USL，打印实测与拟合曲线、系数及更多线程时的预测。
+ *
+ * 超出核数的点测到的是超订而非扩展，核数以内至少有 3 个线程数时只用这些点拟合。
+ * csv_path 非空时把曲线（含 2 倍、4 倍最大线程数的预测点）与拟合参数写入该文件。
+ * @return 写文件失败时返回 false
+ */
+template <typename Include>
+bool print_scaling_analysis(const std::vector<StressTestResult>& summary, Include include, const std::string& csv_path) {
+    std::vector<std::string> backends;
+    for (const auto& result : summary) {
+        if (include(result) && std::find(backends.begin(), backends.end(), result.backend) == backends.end()) {
+            backends.push_back(result.backend);
+        }
+    }
+    if (backends.empty()) {
+        return true;
+    }
+
+    std::ofstream csv;
+    if (!csv_path.empty()) {
+        csv.open(csv_path);
+        if (!csv) {
+            std::cerr << "无法写入扩展性曲线文件: " << csv_path << std::endl;
+            return false;
+        }
+        csv << std::fixed << "backend,threads,measured_ops_per_sec,usl_ops_per_sec,amdahl_ops_per_sec,lambda,sigma,kappa,usl_r2,"
+               "amdahl_sigma,amdahl_r2,peak_threads,fitted_points,fit_at_bound\n";
+    }
+
+    std::vector<std::pair<std::string, ScalingFit>> fits;
+    const int cores = static_cast<int>(online_cpus());
+    for (const auto& backend : backends) {
+        // 线程数 -> 各次吞吐量，只取通过且经由线程池运行（知道线程数）的结果
+        std::vector<std::pair<int, std::vector<double>>> runs;
+        for (const auto& result : summary) {
+            if (result.backend != backend || !include(result) || !result.passed || result.timing.threads.empty()) {
+                continue;
+            }
+            const int threads = static_cast<int>(result.timing.threads.size());
+            auto found = std::find_if(runs.begin(), runs.end(), [threads](const auto& run) { return run.first == threads; });
+            if (found == runs.end()) {
+                runs.push_back({threads, {}});
+                found = runs.end() - 1;
+            }
+            found->second.push_back(result.throughput_ops_per_sec);
+        }
+        std::sort(runs.begin(), runs.end());
+
+        std::vector<ScalingPoint> curve;
+        for (const auto& run : runs) {
+            curve.push_back(ScalingPoint{run.first, median_of(run.second)});
+        }
+        std::vector<ScalingPoint> within_cores;
+        std::copy_if(curve.begin(), curve.end(), std::back_inserter(within_cores),
+                     [cores](const ScalingPoint& point) { return point.threads <= cores; });
+        const bool oversubscribed = within_cores.size() < 3;
+        const ScalingFit fit = fit_scaling(oversubscribed ? curve : within_cores);
+
+        std::cout << "=== 扩展性拟合 [" << backend << "] ===" << std::endl;
+        if (!fit.valid) {
+            std::cout << "缺少单线程或多线程数据，无法拟合\n" << std::endl;
+            continue;
+        }
+        fits.push_back({backend, fit});
+        std::cout << std::string(82, '=') << std::endl;
+        std::cout << std::setw(8) << "线程数" << std::setw(16) << "实测(ops/s)" << std::setw(10) << "加速比"
+                  << std::setw(10) << "效率(%)" << std::setw(18) << "USL(ops/s)" << std::setw(18) << "Amdahl(ops/s)" << std::endl;
+        std::cout << std::string(82, '=') << std::endl;
+        for (const ScalingPoint& point : curve) {
+            const double speedup = point.throughput / fit.lambda;
+            std::cout << std::setw(8) << point.threads << std::setw(16) << std::fixed << std::setprecision(0) << point.throughput
+                      << std::setw(10) << std::setprecision(2) << speedup << std::setw(10) << std::setprecision(1)
+                      << 100.0 * speedup / point.threads << std::setw(18) << std::setprecision(0)
+                      << fit.usl_throughput(point.threads) << std::setw(18) << fit.amdahl_throughput(point.threads) << std::endl;
+        }
+        std::cout << std::string(82, '=') << std::endl;
+
+        const double peak = fit.peak_threads();
+        std::cout << "USL: λ=" << std::setprecision(0) << fit.lambda << " ops/s，σ(竞争)=" << std::setprecision(5) << fit.sigma
+                  << "，κ(一致性)=" << fit.kappa << "，R²=" << std::setprecision(3) << fit.usl_r2 << "；";
+        if (fit.usl_bounded) {
+            std::cout << "σ 落在边界 " << std::setprecision(0) << fit.sigma;
+        } else if (std::isinf(peak)) {
+            std::cout << "无峰值，上限 " << std::setprecision(0)
+                      << (fit.sigma > 0.0 ? fit.lambda / fit.sigma : std::numeric_limits<double>::infinity()) << " ops/s";
+        } else {
+            std::cout << "峰值约 " << std::setprecision(1) << peak << " 线程，" << std::setprecision(0)
+                      << fit.usl_throughput(peak) << " ops/s";
+        }
+        std::cout << std::endl;
+        std::cout << "Amdahl: σ=" << std::setprecision(5) << fit.amdahl_sigma << "，R²=" << std::setprecision(3)
+                  << fit.amdahl_r2 << (fit.amdahl_bounded ? "（σ 落在边界）" : "") << std::endl;
+        const int largest = curve.back().threads;
+        if (fit.usl_bounded || fit.amdahl_bounded) {
+            std::cout << "⚠️ 拟合系数落在 [0,1] 边界，数据不符合模型"
+                      << (fit.sigma >= 1.0 || fit.amdahl_sigma >= 1.0 ? "（加线程后吞吐量反而下降）" : "（超线性加速）")
+                      << "，不报告上限、峰值与预测" << std::endl;
+        } else {
+            std::cout << "预测: " << 2 * largest << " 线程 " << std::setprecision(0) << fit.usl_throughput(2 * largest)
+                      << " ops/s，" << 4 * largest << " 线程 " << fit.usl_throughput(4 * largest) << " ops/s (USL)" << std::endl;
+        }
+        std::cout << "拟合用了 " << fit.points << " 个线程数"
+                  << (oversubscribed ? "，核数以内不足 3 个，包含超订的点，系数反映的是超订而非多核扩展" : "，超出核数的点未参与")
+                  << "\n" << std::endl;
+
+        if (csv.is_open()) {
+            std::vector<ScalingPoint> rows = curve;
+            rows.push_back(ScalingPoint{2 * largest, -1.0});
+            rows.push_back(ScalingPoint{4 * largest, -1.0});
+            for (const ScalingPoint& row : rows) {
+                csv << csv_field(backend) << ',' << row.threads << ',';
+                if (row.throughput >= 0.0) {
+                    csv << std::setprecision(2) << row.throughput;
+                }
+                csv << ',' << fit.usl_throughput(row.threads) << ',' << fit.amdahl_throughput(row.threads) << ','
+                    << fit.lambda << ',' << std::setprecision(8) << fit.sigma << ',' << fit.kappa << ',' << fit.usl_r2
+                    << ',' << fit.amdahl_sigma << ',' << fit.amdahl_r2 << ',';
+                if (!fit.usl_bounded && !std::isinf(peak)) {
+                    csv << std::setprecision(2) << peak;
+                }
+                csv << ',' << fit.points << ',' << (fit.usl_bounded || fit.amdahl_bounded ? 1 : 0) << "\n";
+            }
+        }
+    }
+
+    if (fits.size() > 1) {
+        std::cout << "=== 扩展性系数汇总 (σ 越小越接近线性，κ 越大越早出现峰值后下降) ===" << std::endl;
+        std::cout << std::string(86, '=') << std::endl;
+        std::cout << std::setw(18) << "后端" << std::setw(14) << "σ" << std::setw(14) << "κ" << std::setw(16) << "峰值线程"
+                  << std::setw(16) << "峰值(ops/s)" << std::setw(8) << "R²" << std::endl;
+        std::cout << std::string(86, '=') << std::endl;
+        for (const auto& entry : fits) {
+            const ScalingFit& fit = entry.second;
+            const double peak = fit.peak_threads();
+            std::cout << std::setw(18) << entry.first << std::setw(14) << std::setprecision(5) << fit.sigma
+                      << std::setw(14) << fit.kappa << std::setw(16);
+            if (fit.usl_bounded) {
+                std::cout << "边界" << std::setw(16) << "边界";
+            } else if (std::isinf(peak)) {
+                std::cout << "-" << std::setw(16) << "-";
+            } else {
+                std::cout << std::setprecision(1) << peak << std::setw(16) << std::setprecision(0) << fit.usl_throughput(peak);
+            }
+            std::cout << std::setw(8) << std::setprecision(3) << fit.usl_r2 << std::endl;
+        }
+        std::cout << std::string(86, '=') << "\n" << std::endl;
+    }
+
+    if (csv.is_open()) {
+        csv.flush();
+        if (!csv) {
+            std::cerr << "写入扩展性曲线文件失败: " << csv_path << std::endl;
+            return false;
+        }
+        std::cout << "📄 扩展性曲线与拟合参数已写入 " << csv_path << "\n" << std::endl;
+    }
+    return true;
+}
+
+/**
+ * 把所有测试结果连同主机信息写成 CSV，供仪表盘导入或作为下次比较的基线
+ */
+bool write_csv_report(const std::string& path, const std::vector<StressTestResult>& summary, const HostInfo& host) {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "无法写入报告文件: " << path << std::endl;
+        return false;
+    }
+    out << "# cpu_model=" << host.cpu_model << "\n"
+        << "# cores=" << host.cores << "\n"
+        << "# kernel=" << host.kernel << "\n"
+        << "# compiler=" << host.compiler << "\n"
+        << "# flags=" << host.flags << "\n"
+        << "# timestamp=" << host.timestamp << "\n";
+    out << "backend,test_name,duration_ms,expected_count,actual_count,passed,total_operations,throughput_ops_per_sec,"
+           "fairness_index,max_min_ratio,memory_bytes,max_read_error,cas_failure_rate,"
+           "increment_samples,increment_p50_ns,increment_p90_ns,increment_p99_ns,increment_p999_ns,increment_max_ns,"
+           "get_samples,get_p50_ns,get_p90_ns,get_p99_ns,get_p999_ns,get_max_ns,placement,"
+           "threads,start_skew_ns,end_skew_ns";
+    for (int kind = 0; kind < PERF_EVENT_KINDS; ++kind) {
+        out << ',' << perf_event_name(kind) << "_per_op";
+    }
+    out << ",cpu_ns,user_ns,sys_ns,voluntary_switches,involuntary_switches,futex_calls,ops_per_cpu_sec"
+           ",warmups,trials,throughput_mean,throughput_stddev,throughput_ci_low,throughput_ci_high,outlier_trials\n";
+    for (const auto& result : summary) {
+        out << csv_field(result.backend) << ',' << csv_field(result.test_name) << ',' << result.duration_ms << ','
+            << result.expected_count << ',' << result.actual_count << ',' << (result.passed ? 1 : 0) << ','
+            << result.total_operations << ',' << std::fixed << std::setprecision(2) << result.throughput_ops_per_sec << ','
+            << std::setprecision(6) << result.fairness_index << ',' << result.max_min_ratio << ','
+            << result.memory_bytes << ',' << result.max_read_error << ',' << result.cas_failure_rate;
+        for (const LatencySummary* latency : {&result.increment_latency, &result.get_latency}) {
+            out << ',' << latency->samples << ',' << latency->p50 << ',' << latency->p90 << ','
+                << latency->p99 << ',' << latency->p999 << ',' << latency->max;
+        }
+        out << ',' << csv_field(result.placement);
+        if (result.timing.threads.empty()) {
+            out << ",,,";
+        } else {
+            out << ',' << result.timing.threads.size() << ',' << result.timing.start_skew_ns() << ','
+                << result.timing.end_skew_ns();
+        }
+        // 硬件计数不可用的列留空
+        const PerfSample counters = result.timing.counters();
+        for (int kind = 0; kind < PERF_EVENT_KINDS; ++kind) {
+            out << ',';
+            if (counters.available(kind) && result.total_operations > 0) {
+                out << std::setprecision(4) << counters.per_operation(kind, result.total_operations);
+            }
+        }
+        const CpuUsage usage = result.timing.usage();
+        if (usage.threads == 0) {
+            out << ",,,,,,,";
+        } else {
+            out << ',' << usage.cpu_ns << ',' << usage.user_ns << ',' << usage.sys_ns << ',' << usage.voluntary_switches << ','
+                << usage.involuntary_switches << ',';
+            // futex 次数无法观测时留空
+            if (counters.available(PERF_FUTEX_CALLS)) {
+                out << std::setprecision(0) << counters.counts[PERF_FUTEX_CALLS];
+            }
+            out << ',' << std::setprecision(2) << usage.operations_per_cpu_second(result.total_operations);
+        }
+        // 只试验一次时统计列留空，throughput_ops_per_sec 即该次结果
+        const TrialStatistics& trials = result.trials;
+        if (trials.trials == 0) {
+            out << ",,,,,,,\n";
+        } else {
+            out << ',' << trials.warmups << ',' << trials.trials << ',' << std::setprecision(2) << trials.mean << ','
+                << trials.stddev << ',' << trials.ci_low << ',' << trials.ci_high << ',' << trials.outliers.size() << "\n";
+        }
+    }
+    out.flush();
+    if (!out) {
+        std::cerr << "写入报告文件失败: " << path << std::endl;
+        return false;
+    }
+    std::cout << "📄 结果已写入 " << path << " (" << summary.size() << " 条)\n" << std::endl;
+    return true;
+}
+
+/// (后端, 场景) 在 summary 中第几次出现，从 0 开始
+inline int occurrence_of(const std::vector<StressTestResult>& summary, size_t index) {
+    int occurrence = 0;
+    for (size_t i = 0; i < index; ++i) {
+        if (summary[i].backend == summary[index].backend && summary[i].test_name == summary[index].test_name) {
+            ++occurrence;
+        }
+    }
+    return occurrence;
+}
+
+/**
+ * 把经由 WorkerPool 运行的场景中每个线程的起止时刻（相对开闸，纳秒）写成 CSV，
+ * 用于检查线程是否真正同时开始、同时竞争
+ */
+bool write_thread_timings(const std::string& path, const std::vector<StressTestResult>& summary) {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "无法写入线程时刻文件: " << path << std::endl;
+        return false;
+    }
+    out << "backend,test_name,occurrence,thread,start_ns,end_ns\n";
+    size_t rows = 0;
+    for (size_t i = 0; i < summary.size(); ++i) {
+        const StressTestResult& result = summary[i];
+        const int occurrence = occurrence_of(summary, i);
+        for (size_t t = 0; t < result.timing.threads.size(); ++t) {
+            out << csv_field(result.backend) << ',' << csv_field(result.test_name) << ',' << occurrence << ',' << t << ','
+                << result.timing.threads[t].start_ns << ',' << result.timing.threads[t].end_ns << "\n";
+            ++rows;
+        }
+    }
+    out.flush();
+    if (!out) {
+        std::cerr << "写入线程时刻文件失败: " << path << std::endl;
+        return false;
+    }
+    std::cout << "📄 线程起止时刻已写入 " << path << " (" << rows << " 行)\n" << std::endl;
+    return true;
+}
+
+/// 基线中参与比较的字段；同一后端同名场景可能出现多次，按出现顺序配对
+struct BaselineRecord {
+    std::string backend;
+    std::string test_name;
+    int occurrence;
+    double throughput_ops_per_sec;
+    std::uint64_t increment_p99_ns;
+    std::uint64_t get_p99_ns;
+};
+
+/**
+ * 读取 write_csv_report() 写出的基线文件；按表头名取列，缺失的延迟列视为未测量
+ */
+bool load_baseline(const std::string& path, std::vector<BaselineRecord>& records) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "无法打开基线文件: " << path << std::endl;
+        return false;
+    }
+    std::string line;
+    std::vector<std::string> header;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        const std::vector<std::string> fields = parse_csv_line(line);
+        if (header.empty()) {
+            header = fields;
+            continue;
+        }
+        auto column = [&header, &fields](const char* name) -> std::string {
+            const auto it = std::find(header.begin(), header.end(), name);
+            const size_t index = static_cast<size_t>(it - header.begin());
+            return it != header.end() && index < fields.size() ? fields[index] : std::string();
+        };
+        BaselineRecord record;
+        record.backend = column("backend");
+        record.test_name = column("test_name");
+        record.occurrence = 0;
+        for (const auto& previous : records) {
+            if (previous.backend == record.backend && previous.test_name == record.test_name) {
+                ++record.occurrence;
+            }
+        }
+        try {
+            record.throughput_ops_per_sec = std::stod(column("throughput_ops_per_sec"));
+            const std::string increment_p99 = column("increment_p99_ns");
+            const std::string get_p99 = column("get_p99_ns");
+            record.increment_p99_ns = increment_p99.empty() ? 0 : std::stoull(increment_p99);
+            record.get_p99_ns = get_p99.empty() ? 0 : std::stoull(get_p99);
+        } catch (const std::exception&) {
+            std::cerr << "基线文件格式错误: " << path << " 中的行: " << line << std::endl;
+            return false;
+        }
+        records.push_back(record);
+    }
+    if (header.empty()) {
+        std::cerr << "基线文件为空: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * 与基线逐条比较：吞吐量下降或 p99 延迟上升超过 threshold_percent 即视为回归
+ *
+ * 延迟只在两边都测量过时比较；基线中没有的新场景与本次没有运行的旧场景
+ * 只计数，不算回归。
+ * @return 回归的条数
+ */
+int compare_with_baseline(const std::vector<StressTestResult>& summary, const std::vector<BaselineRecord>& baseline,
+                          double threshold_percent) {
+    const double ratio = threshold_percent / 100.0;
+    std::cout << "=== 基线比较 (阈值 " << std::fixed << std::setprecision(1) << threshold_percent << "%) ===" << std::endl;
+    std::cout << std::string(102, '=') << std::endl;
+    std::cout << std::setw(18) << "后端" << std::setw(32) << "测试场景" << std::setw(20) << "指标"
+              << std::setw(16) << "基线" << std::setw(16) << "本次" << std::endl;
+    std::cout << std::string(102, '=') << std::endl;
+
+    int regressions = 0;
+    int compared = 0;
+    std::vector<bool> matched(baseline.size(), false);
+    auto report = [&regressions](const StressTestResult& result, const char* metric, double before, double after) {
+        std::cout << std::setw(18) << result.backend << std::setw(32) << result.test_name << std::setw(20) << metric
+                  << std::setw(16) << std::setprecision(0) << before << std::setw(16) << after << std::endl;
+        ++regressions;
+    };
+    for (size_t i = 0; i < summary.size(); ++i) {
+        const StressTestResult& result = summary[i];
+        const int occurrence = occurrence_of(summary, i);
+        for (size_t j = 0; j < baseline.size(); ++j) {
+            const BaselineRecord& record = baseline[j];
+            if (record.backend != result.backend || record.test_name != result.test_name || record.occurrence != occurrence) {
+                continue;
+            }
+            matched[j] = true;
+            ++compared;
+            if (result.throughput_ops_per_sec < record.throughput_ops_per_sec * (1.0 - ratio)) {
+                report(result, "吞吐量(ops/s)", record.throughput_ops_per_sec, result.throughput_ops_per_sec);
+            }
+            if (result.increment_latency.samples > 0 && record.increment_p99_ns > 0 &&
+                result.increment_latency.p99 > record.increment_p99_ns * (1.0 + ratio)) {
+                report(result, "increment p99", record.increment_p99_ns, result.increment_latency.p99);
+            }
+            if (result.get_latency.samples > 0 && record.get_p99_ns > 0 &&
+                result.get_latency.p99 > record.get_p99_ns * (1.0 + ratio)) {
+                report(result, "get p99", record.get_p99_ns, result.get_latency.p99);
+            }
+            break;
+        }
+    }
+    std::cout << std::string(102, '=') << std::endl;
+    const long missing = std::count(matched.begin(), matched.end(), false);
+    std::cout << "已比较 " << compared << " 条，回归 " << regressions << " 项；基线中没有的新场景 "
+              << summary.size() - compared << " 条，本次未运行的基线场景 " << missing << " 条\n" << std::endl;
+    return regressions;
+}
+
+/**
+ * 打印 CPU 拓扑与线程放置策略；绑定时列出前若干个位置的 CPU
+ */
+void print_placement() {
+    const CpuTopology& topology = CpuTopology::instance();
+    const ThreadPlacement& placement = ThreadPlacement::instance();
+    std::cout << "CPU 拓扑: " << topology.num_packages() << " 插槽, " << topology.num_cores() << " 物理核, "
+              << topology.cpus().size() << " 逻辑 CPU" << std::endl;
+    std::cout << "线程放置: " << placement.name();
+    const std::vector<int>& order = placement.cpu_order();
+    if (!order.empty()) {
+        const size_t shown = std::min<size_t>(order.size(), 16);
+        std::cout << " (线程 0.." << shown - 1 << " -> CPU";
+        for (size_t i = 0; i < shown; ++i) {
+            std::cout << (i == 0 ? " " : ",") << order[i];
+        }
+        std::cout << (order.size() > shown ? ",...)" : ")");
+    }
+    std::cout << std::endl;
+}
+
+/**
+ * 探测并打印可用的硬件性能计数器；一个都打不开时说明原因，之后的场景不再统计
+ */
+void print_perf_support() {
+    std::cout << "硬件计数器: ";
+    if (!PerfCounters::enabled()) {
+        std::cout << "已关闭" << std::endl;
+        return;
+    }
+    int errors[PERF_EVENT_KINDS];
+    if (PerfCounters::probe(errors) == 0) {
+        std::cout << "不可用 (" << std::strerror(errors[PERF_CYCLES]) << "，容器或虚拟机中常见)，跳过；futex 调用次数记为 n/a" << std::endl;
+        return;
+    }
+    for (int kind = 0; kind < PERF_EVENT_KINDS; ++kind) {
+        if (errors[kind] == 0) {
+            std::cout << perf_event_name(kind) << " ";
+        }
+    }
+    std::cout << (PerfCounters::user_only() ? "(仅用户态)" : "(用户态+内核态)");
+    for (int kind = 0; kind < PERF_EVENT_KINDS; ++kind) {
+        if (errors[kind] != 0) {
+            std::cout << "，" << perf_event_name(kind) << " 不可用";
+        }
+    }
+    std::cout << std::endl;
+}
+
+/**
+ * 默认的完整测试套件：所有后端的全部场景，以及各专题扫描
+ */
+void run_full_suite(std::vector<StressTestResult>& summary) {
+    for_each_backend(AllBackends(), [&summary](auto tag) {
+        run_all_scenarios<typename decltype(tag)::type>(summary);
+    });
+
+    // 多字段统计对象：seqlock 快照一致性校验
+    summary.push_back(run_trials([]() {
+        SeqlockStatistics<> statistics;
+        return mixed_read_write_stress_test(statistics, 4, 200000, 4);
+    }));
+
+    // 唯一序号：宽度 × 线程数扫描
+    const int max_sequence_threads = static_cast<int>(online_cpus()) * 4;
+    for_each_backend(SequenceBackends(), [&summary, max_sequence_threads](auto tag) {
+        for (int threads = 1; threads <= max_sequence_threads; threads *= 2) {
+            summary.push_back(run_trials([threads]() {
+                ThreadSafeCounter<typename decltype(tag)::type> counter;
+                return unique_sequence_test(counter, threads, 100000);
+            }));
+            print_lock_profile();
+        }
+    });
+
+    // 按块预留的 ID 分配器：与上面逐个递增的 atomic/mutex 对比吞吐量
+    for_each_backend(IdAllocatorBackends(), [&summary, max_sequence_threads](auto tag) {
+        for (int threads = 1; threads <= max_sequence_threads; threads *= 2) {
+            summary.push_back(run_trials([threads]() {
+                BlockIdAllocator<typename decltype(tag)::type> allocator;
+                return id_allocator_test(allocator, threads, 100000);
+            }));
+            print_lock_profile();
+        }
+        summary.push_back(run_trials([]() {
+            BlockIdAllocator<typename decltype(tag)::type> allocator;
+            return id_allocator_test(allocator, 4, 100000, 5000);
+        }));
+        print_lock_profile();
+    });
+
+    // CAS 循环：各退避策略在 1 到 4 倍核数线程下的吞吐量与失败率分布
+    for_each_backend(BackoffPolicies(), [&summary, max_sequence_threads](auto tag) {
+        for (int threads = 1; threads <= max_sequence_threads; threads *= 2) {
+            summary.push_back(run_trials([threads]() { return cas_backoff_test<typename decltype(tag)::type>(threads, 200000); }));
+        }
+    });
+
+    // 粗略计数器：刷新阈值 S 对吞吐量和读取误差的影响
+    for_each_backend(SloppyBackends(), [&summary](auto tag) {
+        summary.push_back(long_running_stability_test<typename decltype(tag)::type>(2));
+    });
+
+#ifndef COUNTER_LOCK_PROFILING
+    // 大量计数器：对比锁的体积对内存占用的影响
+    for_each_backend(CompactBackends(), [&summary](auto tag) {
+        summary.push_back(run_trials([]() {
+            return counter_array_test<typename decltype(tag)::type>(COUNTER_ARRAY_SIZE, 4, 1000000);
+        }));
+    });
+#else
+    // 剖析包装层会让每把锁多出分片表，测出的体积不再代表锁本身
+    std::cout << "已开启锁竞争剖析，跳过计数器数组测试\n" << std::endl;
+#endif
+
+    print_side_by_side(summary);
+    print_cpu_efficiency(summary);
+    print_fairness_summary(summary);
+    print_memory_summary(summary);
+    print_read_error_summary(summary);
+    print_cas_summary(summary);
+}
+
+/**
+ * 命令行选项；不带参数时与原来一样只打印到终端
+ */
+struct BenchmarkOptions {
+    std::string csv_path;           ///< --csv：结果写入该文件
+    std::string baseline_path;      ///< --baseline：与该基线文件比较
+    double threshold_percent = 10.0;///< --threshold：回归阈值（百分比）
+    std::string placement = "none"; ///< --placement：线程放置策略，见 ThreadPlacement
+    std::string thread_csv_path;    ///< --thread-csv：各线程起止时刻写入该文件
+    bool perf = true;               ///< --perf on|off：是否统计硬件性能计数器
+
+    // 负载扫描：给出下面任一参数时只运行命令行描述的负载，不再运行完整测试套件
+    bool sweep = false;
+    std::vector<std::string> backends;  ///< --backend：逗号分隔的后端名，为空表示全部
+    std::vector<int> thread_counts;     ///< --threads：为空时取 1 到 4 倍核数、每次翻倍
+    Workload workload;                  ///< --ops / --duration / --read-ratio / --think-ns
+    int repetitions = 1;                ///< --repeat：每个 (后端, 线程数) 组合运行的次数
+
+    // 扩展性模式：按负载扫描运行（每线程固定工作量），再拟合 Amdahl/USL
+    bool scaling = false;               ///< --scaling
+    std::string scaling_csv_path;       ///< --scaling-csv：曲线与拟合参数写入该文件
+
+    TrialSettings trials;               ///< --warmup / --trials / --ci-target / --max-trials，所有模式通用
+};
+
+/**
+ * 解析整数取值并检查范围；失败时打印原因
+ */
+bool parse_number(const std::string& option, const std::string& value, long min, long max, long& result) {
+    char* end = nullptr;
+    errno = 0;
+    const long parsed = std::strtol(value.c_str(), &end, 10);
+    if (end == value.c_str() || *end != '\0' || errno != 0 || parsed < min || parsed > max) {
+        std::cerr << option << " 的取值应为 " << min << " 到 " << max << " 之间的整数: " << value << std::endl;
+        return false;
+    }
+    result = parsed;
+    return true;
+}
+
+/**
+ * 解析线程数列表：逗号分隔，每项为单个数或区间
+ *
+ * 区间写作 起..止，默认步长 +1；起..止:x倍数 按倍数增长，起..止:+步长 按步长增长，
+ * 例如 "1..64:x2" 为 1,2,4,...,64，"4..16:+4,24" 为 4,8,12,16,24。
+ */
+bool parse_thread_counts(const std::string& spec, std::vector<int>& counts) {
+    const long max_threads = 4096;
+    std::stringstream in(spec);
+    std::string item;
+    while (std::getline(in, item, ',')) {
+        const size_t dots = item.find("..");
+        long first = 0;
+        if (dots == std::string::npos) {
+            if (!parse_number("--threads", item, 1, max_threads, first)) {
+                return false;
+            }
+            counts.push_back(static_cast<int>(first));
+            continue;
+        }
+        const size_t colon = item.find(':', dots);
+        const std::string step = colon == std::string::npos ? "+1" : item.substr(colon + 1);
+        long last = 0;
+        long amount = 0;
+        if (!parse_number("--threads", item.substr(0, dots), 1, max_threads, first) ||
+            !parse_number("--threads", item.substr(dots + 2, colon == std::string::npos ? std::string::npos : colon - dots - 2),
+                          first, max_threads, last) ||
+            step.size() < 2 || (step[0] != 'x' && step[0] != '+') ||
+            !parse_number("--threads 步长", step.substr(1), step[0] == 'x' ? 2 : 1, max_threads, amount)) {
+            std::cerr << "无效的线程数区间: " << item << "（例如 1..64:x2 或 4..16:+4）" << std::endl;
+            return false;
+        }
+        for (long threads = first; threads <= last; threads = step[0] == 'x' ? threads * amount : threads + amount) {
+            counts.push_back(static_cast<int>(threads));
+        }
+    }
+    if (counts.empty()) {
+        std::cerr << "线程数列表为空: " << spec << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void print_usage(const char* program) {
+    std::cerr << "用法: " << program << " [--csv 文件] [--baseline 基线文件] [--threshold 百分比] [--placement 策略]\n"
+              << "       [--thread-csv 文件] [--perf on|off]\n"
+              << "       [--backend 名称,...] [--threads 列表] [--ops 次数 | --duration 毫秒] [--read-ratio 百分比]\n"
+              << "       [--think-ns 纳秒] [--repeat 次数] [--scaling [--scaling-csv 文件]]\n"
+              << "       [--warmup 次数] [--trials 次数] [--ci-target 百分比] [--max-trials 次数]\n"
+              << "不带负载参数时运行完整测试套件；给出任一负载参数时只运行对应的负载扫描：\n"
+              << "  --backend    后端名，逗号分隔，默认全部（如 mutex,atomic）\n"
+              << "  --threads    线程数，逗号分隔，可写区间 1..64:x2 或 4..16:+4，默认 1 到 4 倍核数每次翻倍\n"
+              << "  --ops        每个线程的操作数，默认 100000\n"
+              << "  --duration   改为按时长运行（毫秒）\n"
+              << "  --read-ratio get() 占操作的百分比，默认 0\n"
+              << "  --think-ns   两次操作之间忙等的纳秒数，默认 0\n"
+              << "  --repeat     每个组合重复的次数，默认 1\n"
+              << "  --scaling    扩展性模式：每线程固定操作数扫描线程数，拟合 Amdahl/USL 的竞争与一致性系数并预测更多线程时的吞吐量\n"
+              << "  --scaling-csv 扩展性曲线与拟合参数写入该文件（完整测试套件中的扩展性测试同样适用）\n"
+              << "通用参数：\n"
+              << "  --csv        把所有结果与主机信息写成 CSV\n"
+              << "  --baseline   与之前 --csv 写出的文件比较，吞吐量下降或 p99 延迟上升超过阈值时以退出码 2 结束\n"
+              << "  --threshold  回归阈值，默认 10 (%)\n"
+              << "  --placement  线程放置: none（默认）、compact、scatter、per-socket 或 cpus:0,2,4-7\n"
+              << "  --thread-csv 每个线程相对开闸的开始/结束时刻 (ns)\n"
+              << "  --warmup     每个场景正式试验前静默运行的次数，默认 0\n"
+              << "  --trials     每个场景的试验次数，默认 1；多于 1 次时报告中位数/均值/标准差/95% CI 与离群试验，吞吐量取中位数\n"
+              << "  --ci-target  持续追加试验，直到 95% CI 半宽不超过均值的该百分比（至少 3 次）\n"
+              << "  --max-trials 按 --ci-target 追加试验的上限，默认 30\n"
+              << "  --perf       每个场景统计每次操作的周期、指令、缓存/LLC 缺失与 HITM，默认 on；不可用时自动跳过" << std::endl;
+}
+
+bool parse_options(int argc, char* argv[], BenchmarkOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--scaling") {
+            options.scaling = true;
+            options.sweep = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "未知或缺少取值的参数: " << arg << std::endl;
+            return false;
+        }
+        const std::string value = argv[++i];
+        if (arg == "--csv") {
+            options.csv_path = value;
+        } else if (arg == "--baseline") {
+            options.baseline_path = value;
+        } else if (arg == "--thread-csv") {
+            options.thread_csv_path = value;
+        } else if (arg == "--scaling-csv") {
+            options.scaling_csv_path = value;
+        } else if (arg == "--placement") {
+            options.placement = value;
+        } else if (arg == "--perf") {
+            if (value != "on" && value != "off") {
+                std::cerr << "--perf 的取值应为 on 或 off: " << value << std::endl;
+                return false;
+            }
+            options.perf = value == "on";
+        } else if (arg == "--backend") {
+            std::stringstream names(value);
+            std::string name;
+            while (std::getline(names, name, ',')) {
+                options.backends.push_back(name);
+            }
+            options.sweep = true;
+        } else if (arg == "--threads") {
+            if (!parse_thread_counts(value, options.thread_counts)) {
+                return false;
+            }
+            options.sweep = true;
+        } else if (arg == "--ops" || arg == "--duration" || arg == "--read-ratio" || arg == "--think-ns" || arg == "--repeat") {
+            long number = 0;
+            const long max = arg == "--read-ratio" ? 100 : arg == "--duration" ? 3600 * 1000 : std::numeric_limits<int>::max();
+            if (!parse_number(arg, value, arg == "--read-ratio" || arg == "--think-ns" ? 0 : 1, max, number)) {
+                return false;
+            }
+            if (arg == "--ops") {
+                options.workload.ops_per_thread = number;
+            } else if (arg == "--duration") {
+                options.workload.duration_ms = static_cast<int>(number);
+            } else if (arg == "--read-ratio") {
+                options.workload.read_percent = static_cast<int>(number);
+            } else if (arg == "--think-ns") {
+                options.workload.think_ns = number;
+            } else {
+                options.repetitions = static_cast<int>(number);
+            }
+            options.sweep = true;
+        } else if (arg == "--warmup" || arg == "--trials" || arg == "--max-trials") {
+            long number = 0;
+            if (!parse_number(arg, value, arg == "--warmup" ? 0 : 1, 10000, number)) {
+                return false;
+            }
+            (arg == "--warmup" ? options.trials.warmups : arg == "--trials" ? options.trials.trials
+                                                                              : options.trials.max_trials) = static_cast<int>(number);
+        } else if (arg == "--ci-target") {
+            char* end = nullptr;
+            options.trials.ci_target_percent = std::strtod(value.c_str(), &end);
+            if (end == value.c_str() || *end != '\0' || !(options.trials.ci_target_percent > 0.0)) {
+                std::cerr << "无效的置信区间目标: " << value << std::endl;
+                return false;
+            }
+        } else if (arg == "--threshold") {
+            char* end = nullptr;
+            options.threshold_percent = std::strtod(value.c_str(), &end);
+            if (end == value.c_str() || *end != '\0' || options.threshold_percent < 0.0) {
+                std::cerr << "无效的阈值: " << value << std::endl;
+                return false;
+            }
+        } else {
+            std::cerr << "未知参数: " << arg << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * 负载扫描：对选中的每个后端、每个线程数运行 repetitions 次 workload_test
+ * @return 有无法识别的后端名时打印可选名称并返回 false
+ */
+bool run_sweep(const BenchmarkOptions& options, std::vector<StressTestResult>& summary) {
+    std::vector<std::string> available;
+    for_each_backend(AllBackends(), [&available](auto tag) {
+        available.push_back(decltype(tag)::type::name());
+    });
+    for (const std::string& name : options.backends) {
+        if (std::find(available.begin(), available.end(), name) == available.end()) {
+            std::cerr << "未知后端: " << name << "，可选:";
+            for (const std::string& candidate : available) {
+                std::cerr << " " << candidate;
+            }
+            std::cerr << std::endl;
+            return false;
+        }
+    }
+
+    std::vector<int> thread_counts = options.thread_counts;
+    if (thread_counts.empty()) {
+        for (int threads = 1; threads <= static_cast<int>(online_cpus()) * 4; threads *= 2) {
+            thread_counts.push_back(threads);
+        }
+    }
+    for_each_backend(AllBackends(), [&options, &summary, &thread_counts](auto tag) {
+        typedef typename decltype(tag)::type Policy;
+        if (!options.backends.empty() &&
+            std::find(options.backends.begin(), options.backends.end(), Policy::name()) == options.backends.end()) {
+            return;
+        }
+        for (int threads : thread_counts) {
+            for (int repetition = 1; repetition <= options.repetitions; ++repetition) {
+                summary.push_back(run_trials([&options, threads, repetition]() {
+                    ThreadSafeCounter<Policy> counter;
+                    return workload_test(counter, threads, options.workload, repetition);
+                }));
+                print_lock_profile();
+            }
+        }
+    });
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    BenchmarkOptions options;
+    if (!parse_options(argc, argv, options)) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    if (!ThreadPlacement::instance().configure(options.placement)) {
+        return 1;
+    }
+    PerfCounters::set_enabled(options.perf);
+    trial_settings() = options.trials;
+    // 先读基线，文件有问题时不必等全部测试跑完才发现
+    std::vector<BaselineRecord> baseline;
+    if (!options.baseline_path.empty() && !load_baseline(options.baseline_path, baseline)) {
+        return 1;
+    }
+
+    if (options.scaling && options.workload.duration_ms > 0) {
+        std::cerr << "--scaling 需要每线程固定的工作量，不能与 --duration 同用" << std::endl;
+        return 1;
+    }
+
+    std::cout << "🎯 线程安全计数器全面压力测试套件" << std::endl;
+    std::cout << "开始时间: " << __TIME__ << std::endl;
+    print_placement();
+    print_perf_support();
+    std::cout << std::string(50, '=') << std::endl;
+
+    try {
+        std::vector<StressTestResult> summary;
+        if (options.sweep) {
+            if (!run_sweep(options, summary)) {
+                return 1;
+            }
+            print_side_by_side(summary);
+            print_cpu_efficiency(summary);
+        } else {
+            run_full_suite(summary);
+        }
+        // 扩展性模式拟合全部扫描结果；完整套件拟合其中的扩展性测试
+        const bool full_suite = !options.sweep;
+        if ((options.scaling || full_suite) &&
+            !print_scaling_analysis(summary, [full_suite](const StressTestResult& result) {
+                return !full_suite || result.test_name.compare(0, std::string("扩展性(").size(), "扩展性(") == 0;
+            }, options.scaling_csv_path)) {
+            return 1;
+        }
+
+        if (!options.csv_path.empty() && !write_csv_report(options.csv_path, summary, host_info())) {
+            return 1;
+        }
+        if (!options.thread_csv_path.empty() && !write_thread_timings(options.thread_csv_path, summary)) {
+            return 1;
+        }
+
+        bool all_passed = true;
+        for (const auto& result : summary) {
+            all_passed = all_passed && result.passed;
+        }
+        if (!all_passed) {
+            std::cerr << "❌ 存在失败的测试" << std::endl;
+            return 1;
+        }
+
+        if (!options.baseline_path.empty() && compare_with_baseline(summary, baseline, options.threshold_percent) > 0) {
+            std::cerr << "❌ 相对基线存在性能回归" << std::endl;
+            return 2;
+        }
+
+        std::cout << "🎉 所有压力测试完成！" << std::endl;
+
+    } catch (const std::exception& e) {
+        std::cerr << "❌ 测试失败: " << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "❌ 未知错误导致测试失败" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}